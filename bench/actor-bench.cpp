@@ -0,0 +1,550 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Benchmark suite for regression tracking of channels, select and actors:
+//
+//   pingpong/...     round-trip latency between two threads
+//   throughput/...   SPSC, MPSC and MPMC channel throughput, and MPSC into an actor, for 8 B to 4 KiB messages
+//   select/...       one consumer selecting over 2 to 64 channels fed by one producer
+//   selector/...     the same with a channel::Selector, over 2 to 4096 channels
+//   chain/...        messages forwarded along a chain of 1 to 1000 actors, as in examples/chain-demo.cpp
+//
+// Usage: actor-bench [--format=table|csv|json] [--repetitions=N] [--scale=F] [FILTER...]
+//
+// Only benchmarks whose name contains one of the FILTER substrings are run. Each benchmark runs N times
+// (3 by default), and the run with the median throughput is reported. --scale multiplies the number of
+// operations of every benchmark. The json format writes one JSON object per line. Latencies are in nanoseconds:
+// round trips for ping-pong, and enqueue to dequeue (sampled) or end to end otherwise.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <actor/actor.hpp>
+#include <actor/metrics.hpp>
+#include <actor/selector.hpp>
+#include <actor/spsc_channel.hpp>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+/// Every SampleInterval-th message of the throughput benchmarks carries a timestamp, so that measuring
+/// latencies does not dominate the cost being measured.
+constexpr uint64_t SampleInterval = 16;
+
+constexpr auto ThroughputBufferSize = channel::MessageBufferSize { 1024 };
+
+/// Returns the current time in nanoseconds since the clock's epoch, or 0 if message @p i is not sampled.
+int64_t timestamp(uint64_t i = 0) noexcept
+{
+    if (i % SampleInterval != 0)
+        return 0;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+/// Records the time elapsed since @p sentAt, unless the message was not sampled.
+void record_since(actor::LatencyHistogram& latencies, int64_t sentAt) noexcept
+{
+    if (sentAt != 0)
+        latencies.record(std::chrono::nanoseconds(timestamp() - sentAt));
+}
+
+/// A message of exactly Bytes bytes, starting with its send timestamp.
+template <size_t Bytes>
+struct Payload
+{
+    int64_t sentAt = 0;
+    std::array<std::byte, Bytes - sizeof(int64_t)> padding {};
+};
+
+template <>
+struct Payload<sizeof(int64_t)>
+{
+    int64_t sentAt = 0;
+};
+
+static_assert(sizeof(Payload<8>) == 8);
+static_assert(sizeof(Payload<4096>) == 4096);
+
+struct Measurement
+{
+    uint64_t operations = 0;
+    Clock::duration elapsed {};
+    actor::LatencySummary latency {};
+
+    [[nodiscard]] double operations_per_second() const noexcept
+    {
+        return static_cast<double>(operations) / std::chrono::duration<double>(elapsed).count();
+    }
+};
+
+struct Benchmark
+{
+    std::string name;
+    uint64_t operations;
+    std::function<Measurement(uint64_t operations)> run;
+};
+
+/// Measures the time from now until @p stop returns, together with the latencies recorded meanwhile.
+class Stopwatch
+{
+  public:
+    [[nodiscard]] actor::LatencyHistogram& latencies() noexcept
+    {
+        return *_latencies;
+    }
+
+    [[nodiscard]] Measurement stop(uint64_t operations) const
+    {
+        return Measurement { operations, Clock::now() - _start, _latencies->summary() };
+    }
+
+  private:
+    std::unique_ptr<actor::LatencyHistogram> _latencies = std::make_unique<actor::LatencyHistogram>();
+    Clock::time_point _start = Clock::now();
+};
+
+// ----------------------------------------------------------------------------
+// ping-pong
+
+template <typename ChannelType>
+Measurement pingPong(uint64_t roundTrips)
+{
+    auto ping = ChannelType { channel::MessageBufferSize { 1 } };
+    auto pong = ChannelType { channel::MessageBufferSize { 1 } };
+
+    auto echo = std::thread { [&]() {
+        while (auto value = ping.receive())
+            pong.send(*value);
+        pong.close();
+    } };
+
+    auto stopwatch = Stopwatch {};
+    for (uint64_t i = 0; i < roundTrips; ++i)
+    {
+        auto const start = Clock::now();
+        ping.send(static_cast<int64_t>(i));
+        (void) pong.receive();
+        stopwatch.latencies().record(Clock::now() - start);
+    }
+    auto result = stopwatch.stop(roundTrips);
+
+    ping.close();
+    echo.join();
+    return result;
+}
+
+Measurement actorPingPong(uint64_t roundTrips)
+{
+    auto pong = channel::Channel<int64_t> { channel::MessageBufferSize { 1 } };
+    auto echo = actor::Actor([&](actor::Receiver receiver) {
+        for (actor::Message& message: receiver)
+            message.match<int64_t>([&](int64_t value) { pong.send(value); });
+    });
+
+    auto stopwatch = Stopwatch {};
+    for (uint64_t i = 0; i < roundTrips; ++i)
+    {
+        auto const start = Clock::now();
+        echo.send(static_cast<int64_t>(i));
+        (void) pong.receive();
+        stopwatch.latencies().record(Clock::now() - start);
+    }
+    return stopwatch.stop(roundTrips);
+}
+
+// ----------------------------------------------------------------------------
+// throughput
+
+template <size_t Bytes>
+Measurement channelThroughput(size_t producerCount, size_t consumerCount, uint64_t messageCount)
+{
+    auto channel = channel::Channel<Payload<Bytes>> { ThroughputBufferSize };
+    auto const perProducer = messageCount / producerCount;
+
+    auto stopwatch = Stopwatch {};
+
+    auto consumers = std::vector<std::thread> {};
+    for (size_t c = 0; c < consumerCount; ++c)
+        consumers.emplace_back([&]() {
+            while (auto payload = channel.receive())
+                record_since(stopwatch.latencies(), payload->sentAt);
+        });
+
+    auto producers = std::vector<std::thread> {};
+    for (size_t p = 0; p < producerCount; ++p)
+        producers.emplace_back([&]() {
+            for (uint64_t i = 0; i < perProducer; ++i)
+                channel.send(Payload<Bytes> { .sentAt = timestamp(i) });
+        });
+
+    for (auto& producer: producers)
+        producer.join();
+    channel.close();
+    for (auto& consumer: consumers)
+        consumer.join();
+
+    return stopwatch.stop(perProducer * producerCount);
+}
+
+template <size_t Bytes>
+Measurement actorThroughput(size_t producerCount, uint64_t messageCount)
+{
+    auto executor = actor::Executor {};
+    auto const perProducer = messageCount / producerCount;
+    auto const total = perProducer * producerCount;
+
+    auto stopwatch = Stopwatch {};
+    auto received = std::atomic<uint64_t> { 0 };
+    auto sink = actor::Actor(executor, [&](actor::Message& message) {
+        message.match<Payload<Bytes>>(
+            [&](Payload<Bytes> const& payload) { record_since(stopwatch.latencies(), payload.sentAt); });
+        if (received.fetch_add(1) + 1 == total)
+            received.notify_one();
+    });
+
+    auto producers = std::vector<std::thread> {};
+    for (size_t p = 0; p < producerCount; ++p)
+        producers.emplace_back([&]() {
+            for (uint64_t i = 0; i < perProducer; ++i)
+                sink.send(Payload<Bytes> { .sentAt = timestamp(i) });
+        });
+
+    for (auto& producer: producers)
+        producer.join();
+    for (auto count = received.load(); count != total; count = received.load())
+        received.wait(count);
+
+    return stopwatch.stop(total);
+}
+
+// ----------------------------------------------------------------------------
+// select
+
+template <size_t ChannelCount>
+Measurement selectAcross(uint64_t messageCount)
+{
+    auto controller = channel::Controller {};
+    auto channels = std::deque<channel::Channel<int64_t>> {};
+    for (size_t i = 0; i < ChannelCount; ++i)
+        channels.emplace_back(channel::MessageBufferSize { 64 }, &controller);
+
+    auto stopwatch = Stopwatch {};
+
+    auto producer = std::thread { [&]() {
+        for (uint64_t i = 0; i < messageCount; ++i)
+            channels[i % ChannelCount].send(timestamp(i));
+    } };
+
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        auto received = uint64_t { 0 };
+        while (received < messageCount)
+            for (auto const index: controller.select(channels[I]...))
+                while (auto sentAt = channels[index].try_receive())
+                {
+                    record_since(stopwatch.latencies(), *sentAt);
+                    ++received;
+                }
+    }(std::make_index_sequence<ChannelCount> {});
+
+    auto result = stopwatch.stop(messageCount);
+    producer.join();
+    return result;
+}
+
+Measurement selectorAcross(size_t channelCount, uint64_t messageCount)
+{
+    auto controller = channel::Controller {};
+    auto channels = std::deque<channel::Channel<int64_t>> {};
+    auto selector = channel::Selector { controller };
+    for (size_t i = 0; i < channelCount; ++i)
+        selector.add(channels.emplace_back(channel::MessageBufferSize { 64 }, &controller), i);
+
+    auto stopwatch = Stopwatch {};
+
+    auto producer = std::thread { [&]() {
+        for (uint64_t i = 0; i < messageCount; ++i)
+            channels[i % channelCount].send(timestamp(i));
+    } };
+
+    auto received = uint64_t { 0 };
+    while (received < messageCount)
+        for (auto const key: selector.wait())
+            while (auto sentAt = channels[key].try_receive())
+            {
+                record_since(stopwatch.latencies(), *sentAt);
+                ++received;
+            }
+
+    auto result = stopwatch.stop(messageCount);
+    producer.join();
+    for (auto& channel: channels)
+        selector.remove(channel);
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+// actor chain
+
+/// Sends @p messageCount messages through a chain of @p length actors, each one forwarding to the next.
+///
+/// @p makeActor constructs an actor from its message handler.
+template <typename MakeActor>
+Measurement actorChain(size_t length, uint64_t messageCount, MakeActor makeActor)
+{
+    auto stopwatch = Stopwatch {};
+    auto received = std::atomic<uint64_t> { 0 };
+
+    // Built from the end of the chain, so that each actor already knows its successor.
+    auto actors = std::deque<actor::Actor> {};
+    makeActor(actors, [&](actor::Message& message) {
+        message.match<int64_t>([&](int64_t sentAt) { record_since(stopwatch.latencies(), sentAt); });
+        if (received.fetch_add(1) + 1 == messageCount)
+            received.notify_one();
+    });
+    while (actors.size() < length)
+        makeActor(actors, [next = &actors.front()](actor::Message& message) {
+            message.match<int64_t>([next](int64_t sentAt) { next->send(sentAt); });
+        });
+
+    stopwatch = Stopwatch {};
+    for (uint64_t i = 0; i < messageCount; ++i)
+        actors.front().send(timestamp());
+    for (auto count = received.load(); count != messageCount; count = received.load())
+        received.wait(count);
+
+    return stopwatch.stop(messageCount);
+}
+
+Measurement threadChain(size_t length, uint64_t messageCount)
+{
+    return actorChain(length, messageCount, [](std::deque<actor::Actor>& actors, auto handler) {
+        actors.emplace_front([handler = std::move(handler)](actor::Receiver receiver) mutable {
+            for (actor::Message& message: receiver)
+                handler(message);
+        });
+    });
+}
+
+Measurement executorChain(size_t length, uint64_t messageCount)
+{
+    auto executor = actor::Executor {};
+    return actorChain(length, messageCount, [&](std::deque<actor::Actor>& actors, auto handler) {
+        actors.emplace_front(executor, std::move(handler));
+    });
+}
+
+// ----------------------------------------------------------------------------
+
+template <size_t Bytes>
+void addThroughputBenchmarks(std::vector<Benchmark>& benchmarks)
+{
+    auto const suffix = "/bytes=" + std::to_string(Bytes);
+    auto const operations = uint64_t { 1'000'000 };
+    benchmarks.push_back({ "throughput/spsc" + suffix, operations, [](uint64_t n) {
+                              return channelThroughput<Bytes>(1, 1, n);
+                          } });
+    benchmarks.push_back({ "throughput/mpsc" + suffix, operations, [](uint64_t n) {
+                              return channelThroughput<Bytes>(4, 1, n);
+                          } });
+    benchmarks.push_back({ "throughput/mpmc" + suffix, operations, [](uint64_t n) {
+                              return channelThroughput<Bytes>(4, 4, n);
+                          } });
+    benchmarks.push_back({ "throughput/actor-mpsc" + suffix, operations, [](uint64_t n) {
+                              return actorThroughput<Bytes>(4, n);
+                          } });
+}
+
+template <size_t ChannelCount>
+void addSelectBenchmark(std::vector<Benchmark>& benchmarks)
+{
+    benchmarks.push_back(
+        { "select/channels=" + std::to_string(ChannelCount), 1'000'000, selectAcross<ChannelCount> });
+}
+
+std::vector<Benchmark> allBenchmarks()
+{
+    auto benchmarks = std::vector<Benchmark> {};
+
+    benchmarks.push_back({ "pingpong/channel", 100'000, pingPong<channel::Channel<int64_t>> });
+    benchmarks.push_back({ "pingpong/spsc", 100'000, pingPong<channel::SpscChannel<int64_t>> });
+    benchmarks.push_back({ "pingpong/actor", 100'000, actorPingPong });
+
+    addThroughputBenchmarks<8>(benchmarks);
+    addThroughputBenchmarks<64>(benchmarks);
+    addThroughputBenchmarks<512>(benchmarks);
+    addThroughputBenchmarks<4096>(benchmarks);
+
+    addSelectBenchmark<2>(benchmarks);
+    addSelectBenchmark<4>(benchmarks);
+    addSelectBenchmark<8>(benchmarks);
+    addSelectBenchmark<16>(benchmarks);
+    addSelectBenchmark<32>(benchmarks);
+    addSelectBenchmark<64>(benchmarks);
+
+    for (size_t const channelCount: { 2, 4, 8, 16, 32, 64, 1024, 4096 })
+        benchmarks.push_back({ "selector/channels=" + std::to_string(channelCount),
+                               1'000'000,
+                               [channelCount](uint64_t n) { return selectorAcross(channelCount, n); } });
+
+    for (size_t const length: { 1, 10, 100, 1000 })
+    {
+        // Roughly the same number of hops for every length.
+        auto const operations = std::max<uint64_t>(1'000, 1'000'000 / length);
+        auto const suffix = "/length=" + std::to_string(length);
+        benchmarks.push_back({ "chain/thread" + suffix, operations, [length](uint64_t n) {
+                                  return threadChain(length, n);
+                              } });
+        benchmarks.push_back({ "chain/executor" + suffix, operations, [length](uint64_t n) {
+                                  return executorChain(length, n);
+                              } });
+    }
+
+    return benchmarks;
+}
+
+// ----------------------------------------------------------------------------
+// output
+
+enum class Format
+{
+    Table,
+    Csv,
+    Json,
+};
+
+void printHeader(Format format)
+{
+    switch (format)
+    {
+        case Format::Table:
+            std::cout << std::left << std::setw(36) << "benchmark" << std::right << std::setw(12) << "ops"
+                      << std::setw(16) << "ops/s" << std::setw(10) << "p50 ns" << std::setw(10) << "p90 ns"
+                      << std::setw(10) << "p99 ns" << std::setw(10) << "p999 ns" << std::setw(12) << "max ns"
+                      << '\n';
+            break;
+        case Format::Csv:
+            std::cout << "benchmark,operations,seconds,ops_per_sec,latency_count,latency_mean_ns,latency_p50_ns,"
+                         "latency_p90_ns,latency_p99_ns,latency_p999_ns,latency_max_ns\n";
+            break;
+        case Format::Json: break;
+    }
+}
+
+void printResult(Format format, std::string const& name, Measurement const& result)
+{
+    auto const seconds = std::chrono::duration<double>(result.elapsed).count();
+    auto const& latency = result.latency;
+
+    switch (format)
+    {
+        case Format::Table:
+            std::cout << std::left << std::setw(36) << name << std::right << std::setw(12) << result.operations
+                      << std::setw(16) << std::fixed << std::setprecision(0) << result.operations_per_second()
+                      << std::setw(10) << latency.p50.count() << std::setw(10) << latency.p90.count()
+                      << std::setw(10) << latency.p99.count() << std::setw(10) << latency.p999.count()
+                      << std::setw(12) << latency.max.count() << '\n';
+            break;
+        case Format::Csv:
+            std::cout << name << ',' << result.operations << ',' << std::setprecision(9) << seconds << ','
+                      << std::setprecision(1) << std::fixed << result.operations_per_second() << ','
+                      << latency.count << ',' << latency.mean.count() << ',' << latency.p50.count() << ','
+                      << latency.p90.count() << ',' << latency.p99.count() << ',' << latency.p999.count() << ','
+                      << latency.max.count() << '\n';
+            std::cout.unsetf(std::ios::floatfield);
+            break;
+        case Format::Json: {
+            std::cout << "{\"benchmark\":";
+            actor::detail::write_json_string(std::cout, name);
+            std::cout << ",\"operations\":" << result.operations << ",\"seconds\":" << std::setprecision(9)
+                      << seconds << ",\"ops_per_sec\":" << std::fixed << std::setprecision(1)
+                      << result.operations_per_second() << ",\"latency_ns\":{";
+            std::cout.unsetf(std::ios::floatfield);
+            auto separator = "";
+            actor::detail::write_latency(latency, [&](char const* key, auto value) {
+                std::cout << std::exchange(separator, ",") << '"' << key << "\":" << value;
+            });
+            std::cout << "}}\n";
+            break;
+        }
+    }
+    std::cout.flush();
+}
+
+bool selected(std::string const& name, std::vector<std::string_view> const& filters)
+{
+    if (filters.empty())
+        return true;
+    for (auto const filter: filters)
+        if (name.find(filter) != std::string::npos)
+            return true;
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char const* argv[])
+{
+    auto format = Format::Table;
+    auto repetitions = size_t { 3 };
+    auto scale = 1.0;
+    auto filters = std::vector<std::string_view> {};
+
+    for (int i = 1; i < argc; ++i)
+    {
+        auto const arg = std::string_view { argv[i] };
+        if (arg == "--format=table")
+            format = Format::Table;
+        else if (arg == "--format=csv")
+            format = Format::Csv;
+        else if (arg == "--format=json")
+            format = Format::Json;
+        else if (arg.starts_with("--repetitions="))
+            repetitions = std::max<size_t>(1, std::strtoull(argv[i] + 14, nullptr, 10));
+        else if (arg.starts_with("--scale="))
+            scale = std::strtod(argv[i] + 8, nullptr);
+        else if (arg.starts_with("--"))
+        {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--format=table|csv|json] [--repetitions=N] [--scale=F] [FILTER...]\n";
+            return EXIT_FAILURE;
+        }
+        else
+            filters.push_back(arg);
+    }
+
+    printHeader(format);
+
+    for (auto const& benchmark: allBenchmarks())
+    {
+        if (!selected(benchmark.name, filters))
+            continue;
+
+        auto const operations =
+            std::max<uint64_t>(1, static_cast<uint64_t>(static_cast<double>(benchmark.operations) * scale));
+
+        auto runs = std::vector<Measurement> {};
+        for (size_t i = 0; i < repetitions; ++i)
+            runs.push_back(benchmark.run(operations));
+
+        std::ranges::sort(runs, {}, &Measurement::operations_per_second);
+        printResult(format, benchmark.name, runs[runs.size() / 2]);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Counts heap allocations per message passed from one thread to another in bursts, which outgrow the node cache
+// of mailboxes and the spare segment of unbounded channels, with std::allocator and with actor::PoolAllocator.
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+#include <actor/actor.hpp>
+#include <actor/channel.hpp>
+#include <actor/mailbox.hpp>
+#include <actor/pool_allocator.hpp>
+
+#include "allocation-counter.hpp"
+
+namespace
+{
+
+/// A message payload too large to be stored inline in an actor::Message.
+struct Payload
+{
+    std::array<std::byte, 512> data {};
+};
+
+/// Sends @p messageCount messages in bursts of @p burst, waiting for the receiving thread to drain each burst
+/// before sending the next one. Allocations are counted after a warm-up of the same pattern.
+template <typename Send, typename Receive>
+double allocationsPerMessage(Send send, Receive receive, size_t burst, size_t messageCount)
+{
+    auto const warmUpCount = burst * 4;
+    auto received = std::atomic<size_t> { 0 };
+    auto receiver = std::thread { [&]() {
+        for (size_t i = 0; i < warmUpCount + messageCount; ++i)
+        {
+            receive();
+            received.fetch_add(1, std::memory_order_release);
+        }
+    } };
+
+    auto sendBursts = [&](size_t sent, size_t count) {
+        for (size_t i = 0; i < count; ++i)
+        {
+            send();
+            if ((i + 1) % burst == 0)
+                while (received.load(std::memory_order_acquire) != sent + i + 1)
+                    std::this_thread::yield();
+        }
+    };
+
+    sendBursts(0, warmUpCount);
+    auto const before = bench::allocation_count();
+    sendBursts(warmUpCount, messageCount);
+    auto const allocations = bench::allocation_count() - before;
+
+    receiver.join();
+    return static_cast<double>(allocations) / static_cast<double>(messageCount);
+}
+
+template <typename Allocator>
+double mailboxAllocationsPerMessage(size_t burst, size_t messageCount)
+{
+    auto mailbox = actor::Mailbox<int, Allocator> {};
+    return allocationsPerMessage([&]() { mailbox.push(0); }, [&]() { (void)mailbox.pop(); }, burst, messageCount);
+}
+
+template <typename Allocator>
+double channelAllocationsPerMessage(size_t burst, size_t messageCount)
+{
+    auto channel = channel::Channel<int, Allocator> { channel::MessageBufferSize::unbounded() };
+    return allocationsPerMessage([&]() { channel.send(0); }, [&]() { (void)channel.receive(); }, burst, messageCount);
+}
+
+/// Messages to an actor carry a Payload, which is too large to be stored inline.
+double actorAllocationsPerMessage(size_t burst, size_t messageCount)
+{
+    auto channel = channel::Channel<bool> { channel::MessageBufferSize::unbounded() };
+    auto target = actor::Actor([&](actor::Receiver receiver) {
+        for ([[maybe_unused]] actor::Message& message: receiver)
+            channel.send(true);
+    });
+    return allocationsPerMessage([&]() { target << Payload {}; }, [&]() { (void)channel.receive(); }, burst,
+                                 messageCount);
+}
+
+void print(std::string_view name, size_t burst, double standard, double pooled)
+{
+    std::cout << std::setw(10) << name << std::setw(8) << burst << std::fixed << std::setprecision(4)
+              << std::setw(18) << standard << std::setw(18) << pooled << '\n';
+}
+
+} // namespace
+
+int main(int argc, char const* argv[])
+{
+    auto const messageCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000ULL;
+
+    std::cout << std::setw(10) << "queue" << std::setw(8) << "burst" << std::setw(18) << "std (alloc/msg)"
+              << std::setw(18) << "pool (alloc/msg)" << '\n';
+
+    for (size_t const burst: { 256, 4096, 65536 })
+    {
+        print("mailbox", burst, mailboxAllocationsPerMessage<std::allocator<int>>(burst, messageCount),
+              mailboxAllocationsPerMessage<actor::PoolAllocator<int>>(burst, messageCount));
+        print("channel", burst, channelAllocationsPerMessage<std::allocator<int>>(burst, messageCount),
+              channelAllocationsPerMessage<actor::PoolAllocator<int>>(burst, messageCount));
+    }
+
+    // Actor inboxes and message payloads always use the default allocator, so there is nothing to compare against.
+    for (size_t const burst: { 256, 4096, 65536 })
+        std::cout << std::setw(10) << "actor" << std::setw(8) << burst << std::setw(18) << std::fixed
+                  << std::setprecision(4) << actorAllocationsPerMessage(burst, messageCount) << std::setw(18) << "-"
+                  << '\n';
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Replaces the global allocation functions with ones that count allocations. They live in a translation unit of
+// their own, so that the compiler cannot inline them into callers, and every operator new has its matching
+// operator delete. The array and nothrow forms forward to these in the standard library.
+
+#include "allocation-counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+std::atomic<size_t> allocationCount = 0;
+}
+
+size_t bench::allocation_count() noexcept
+{
+    return allocationCount.load();
+}
+
+void* operator new(size_t size)
+{
+    ++allocationCount;
+    if (auto* p = std::malloc(size))
+        return p;
+    throw std::bad_alloc {};
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    ++allocationCount;
+    auto const align = static_cast<size_t>(alignment);
+    if (auto* p = std::aligned_alloc(align, (size + align - 1) / align * align))
+        return p;
+    throw std::bad_alloc {};
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t /*size*/) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t /*alignment*/) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t /*size*/, std::align_val_t /*alignment*/) noexcept
+{
+    std::free(p);
+}
@@ -0,0 +1,14 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstddef>
+
+namespace bench
+{
+
+/// The number of calls to the global operator new so far, from all threads.
+///
+/// Benchmarks using this are linked with allocation-counter.cpp, which replaces the global allocation functions.
+size_t allocation_count() noexcept;
+
+} // namespace bench
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Counts heap allocations per message passed through a bounded channel,
+// compared to the std::deque based storage that was used before.
+
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include <actor/channel.hpp>
+
+#include "allocation-counter.hpp"
+
+namespace
+{
+
+/// Passes @p messageCount messages from one thread to another through a channel of @p capacity.
+double channelAllocationsPerMessage(size_t capacity, size_t messageCount)
+{
+    auto controller = channel::Controller {};
+    auto channel = controller.channel<int>(channel::MessageBufferSize { capacity });
+
+    auto receiver = std::thread { [&]() {
+        while (channel.receive())
+            ;
+    } };
+
+    // Warm-up, so that thread start-up and lazy initialization are not counted.
+    for (size_t i = 0; i < capacity * 2; ++i)
+        channel.send(0);
+
+    auto const before = bench::allocation_count();
+    for (size_t i = 0; i < messageCount; ++i)
+        channel.send(static_cast<int>(i));
+    auto const allocations = bench::allocation_count() - before;
+
+    channel.close();
+    receiver.join();
+
+    return static_cast<double>(allocations) / static_cast<double>(messageCount);
+}
+
+/// Applies the same fill/drain pattern a bounded channel sees to a plain std::deque, for reference.
+double dequeAllocationsPerMessage(size_t capacity, size_t messageCount)
+{
+    auto queue = std::deque<int> {};
+
+    auto const before = bench::allocation_count();
+    for (size_t i = 0; i < messageCount; ++i)
+    {
+        queue.push_back(static_cast<int>(i));
+        if (queue.size() == capacity)
+            while (!queue.empty())
+                queue.pop_front();
+    }
+    return static_cast<double>(bench::allocation_count() - before) / static_cast<double>(messageCount);
+}
+
+} // namespace
+
+int main(int argc, char const* argv[])
+{
+    auto const messageCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000ULL;
+
+    std::cout << std::setw(10) << "capacity" << std::setw(20) << "deque (alloc/msg)" << std::setw(20)
+              << "channel (alloc/msg)" << '\n';
+
+    for (size_t const capacity: { 1, 16, 256, 4096 })
+        std::cout << std::setw(10) << capacity << std::setw(20) << std::fixed << std::setprecision(4)
+                  << dequeAllocationsPerMessage(capacity, messageCount) << std::setw(20)
+                  << channelAllocationsPerMessage(capacity, messageCount) << '\n';
+
+    return EXIT_SUCCESS;
+}
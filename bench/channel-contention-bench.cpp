@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Measures throughput of many channels sharing one controller, each channel being
+// used by several sending and receiving threads at once.
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <thread>
+#include <vector>
+
+#include <actor/channel.hpp>
+
+namespace
+{
+
+double measure(size_t channelCount, size_t threadsPerChannel, size_t messagesPerChannel)
+{
+    auto controller = channel::Controller {};
+    auto channels = std::list<channel::Channel<int>> {};
+    for (size_t i = 0; i < channelCount; ++i)
+        channels.emplace_back(channel::MessageBufferSize { 16 }, &controller);
+
+    auto const sendersPerChannel = std::max<size_t>(1, threadsPerChannel / 2);
+    auto const receiversPerChannel = std::max<size_t>(1, threadsPerChannel - sendersPerChannel);
+    auto const perSender = messagesPerChannel / sendersPerChannel;
+
+    auto const start = std::chrono::steady_clock::now();
+
+    auto senders = std::vector<std::thread> {};
+    auto receivers = std::vector<std::thread> {};
+    for (auto& channel: channels)
+    {
+        for (size_t i = 0; i < receiversPerChannel; ++i)
+            receivers.emplace_back([&channel]() {
+                while (channel.receive())
+                    ;
+            });
+        for (size_t i = 0; i < sendersPerChannel; ++i)
+            senders.emplace_back([&channel, perSender]() {
+                for (size_t n = 0; n < perSender; ++n)
+                    channel.send(static_cast<int>(n));
+            });
+    }
+
+    for (auto& sender: senders)
+        sender.join();
+    for (auto& channel: channels)
+        channel.close();
+    for (auto& receiver: receivers)
+        receiver.join();
+
+    auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(perSender * sendersPerChannel * channelCount) / elapsed;
+}
+
+} // namespace
+
+int main(int argc, char const* argv[])
+{
+    auto const messagesPerChannel = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000ULL;
+
+    std::cout << std::setw(10) << "channels" << std::setw(10) << "threads" << std::setw(20) << "msg/s" << '\n';
+
+    for (size_t const channelCount: { 1, 4, 16, 64 })
+        for (size_t const threadsPerChannel: { 2, 4, 8 })
+            std::cout << std::setw(10) << channelCount << std::setw(10) << channelCount * threadsPerChannel
+                      << std::setw(20) << std::fixed << std::setprecision(0)
+                      << measure(channelCount, threadsPerChannel, messagesPerChannel / channelCount) << '\n';
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Compares the buffering modes of Channel: rendezvous (no buffer), bounded (preallocated ring buffer)
+// and unbounded (segmented queue).
+//
+// The streaming scenario measures the per-message hand-off cost between one sending and one receiving thread.
+// The burst scenario sends all messages before receiving any, which is where an unbounded channel grows,
+// compared with a bounded channel preallocated to hold the whole burst.
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <actor/channel.hpp>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+double nanosecondsPerMessage(Clock::time_point start, size_t messageCount)
+{
+    auto const elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return elapsed / static_cast<double>(messageCount);
+}
+
+double streaming(channel::MessageBufferSize bufferSize, size_t messageCount)
+{
+    auto channel = channel::Channel<int> { bufferSize };
+
+    auto const start = Clock::now();
+
+    auto sender = std::thread { [&]() {
+        for (size_t i = 0; i < messageCount; ++i)
+            channel.send(static_cast<int>(i));
+        channel.close();
+    } };
+
+    while (channel.receive())
+        ;
+
+    auto const result = nanosecondsPerMessage(start, messageCount);
+    sender.join();
+    return result;
+}
+
+double burst(channel::MessageBufferSize bufferSize, size_t messageCount)
+{
+    auto channel = channel::Channel<int> { bufferSize };
+
+    auto const start = Clock::now();
+
+    for (size_t i = 0; i < messageCount; ++i)
+        channel.send(static_cast<int>(i));
+
+    for (size_t i = 0; i < messageCount; ++i)
+        (void) channel.receive();
+
+    return nanosecondsPerMessage(start, messageCount);
+}
+
+void print(std::string const& scenario, std::string const& mode, double nanoseconds)
+{
+    std::cout << std::setw(12) << scenario << std::setw(16) << mode << std::setw(16) << std::fixed
+              << std::setprecision(1) << nanoseconds << '\n';
+}
+
+} // namespace
+
+int main(int argc, char const* argv[])
+{
+    auto const messageCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000ULL;
+
+    std::cout << std::setw(12) << "scenario" << std::setw(16) << "mode" << std::setw(16) << "ns/msg" << '\n';
+
+    print("streaming", "rendezvous", streaming(channel::MessageBufferSize::rendezvous(), messageCount));
+    print("streaming", "bounded(1)", streaming(channel::MessageBufferSize { 1 }, messageCount));
+    print("streaming", "bounded(1024)", streaming(channel::MessageBufferSize { 1024 }, messageCount));
+    print("streaming", "unbounded", streaming(channel::MessageBufferSize::unbounded(), messageCount));
+
+    print("burst", "bounded(N)", burst(channel::MessageBufferSize { messageCount }, messageCount));
+    print("burst", "unbounded", burst(channel::MessageBufferSize::unbounded(), messageCount));
+
+    return EXIT_SUCCESS;
+}
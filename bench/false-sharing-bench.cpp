@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Measures cache misses per message between one sending and one receiving thread, for a single channel and for
+// pairs of channels laid out side by side, each used by a thread pair of its own. Channels whose state shares
+// cache lines with their neighbours show up as more L1D misses per message in the side-by-side runs.
+//
+// Hardware counters are read through perf_event_open on Linux. Where they are unavailable (other platforms,
+// virtual machines without a PMU, or a restrictive kernel.perf_event_paranoid), only the time is reported.
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string_view>
+#include <thread>
+
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+#include <actor/spsc_channel.hpp>
+
+namespace
+{
+
+/// A hardware event counted for the calling thread and all threads it starts while the counter is open.
+class PerfCounter
+{
+  public:
+    PerfCounter(uint32_t type, uint64_t config)
+    {
+#if defined(__linux__)
+        auto attributes = perf_event_attr {};
+        std::memset(&attributes, 0, sizeof(attributes));
+        attributes.size = sizeof(attributes);
+        attributes.type = type;
+        attributes.config = config;
+        attributes.disabled = 1;
+        attributes.inherit = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        _fd = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+#else
+        (void) type;
+        (void) config;
+#endif
+    }
+
+    PerfCounter(PerfCounter const&) = delete;
+    PerfCounter& operator=(PerfCounter const&) = delete;
+
+    ~PerfCounter()
+    {
+#if defined(__linux__)
+        if (_fd >= 0)
+            close(_fd);
+#endif
+    }
+
+    void start() noexcept
+    {
+#if defined(__linux__)
+        if (_fd >= 0)
+        {
+            ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /// Stops counting, returning the count, or std::nullopt if the event is not supported.
+    std::optional<uint64_t> stop() noexcept
+    {
+#if defined(__linux__)
+        auto count = uint64_t { 0 };
+        if (_fd >= 0 && ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0) == 0 && read(_fd, &count, sizeof(count)) == sizeof(count))
+            return count;
+#endif
+        return std::nullopt;
+    }
+
+  private:
+    int _fd = -1;
+};
+
+struct Result
+{
+    double nanosecondsPerMessage = 0;
+    std::optional<double> l1dMissesPerMessage;
+    std::optional<double> cacheMissesPerMessage;
+};
+
+/// A channel and its controller, as they would be laid out as members of some object.
+template <typename ChannelType>
+struct Link
+{
+    channel::Controller controller;
+    ChannelType channel { channel::MessageBufferSize { 1024 }, &controller };
+};
+
+/// Passes @p messageCount messages over each of @p Count adjacent links, each by a sender and receiver thread
+/// of its own.
+template <typename ChannelType, size_t Count>
+Result measure(size_t messageCount)
+{
+#if defined(__linux__)
+    auto l1dMisses = PerfCounter { PERF_TYPE_HW_CACHE,
+                                   PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                       | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) };
+    auto cacheMisses = PerfCounter { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES };
+#else
+    auto l1dMisses = PerfCounter { 0, 0 };
+    auto cacheMisses = PerfCounter { 0, 0 };
+#endif
+
+    auto links = std::array<Link<ChannelType>, Count> {};
+    auto threads = std::array<std::thread, Count * 2> {};
+
+    l1dMisses.start();
+    cacheMisses.start();
+    auto const start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        auto& channel = links[i].channel;
+        threads[i * 2] = std::thread { [&channel, messageCount]() {
+            for (size_t j = 0; j < messageCount; ++j)
+                channel.send(static_cast<int>(j));
+            channel.close();
+        } };
+        threads[i * 2 + 1] = std::thread { [&channel]() {
+            while (channel.receive())
+                ;
+        } };
+    }
+    for (auto& thread: threads)
+        thread.join();
+
+    auto const elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    auto const messages = static_cast<double>(messageCount * Count);
+    auto const perMessage = [messages](std::optional<uint64_t> count) -> std::optional<double> {
+        if (!count)
+            return std::nullopt;
+        return static_cast<double>(*count) / messages;
+    };
+
+    return Result { .nanosecondsPerMessage = elapsed / messages,
+                    .l1dMissesPerMessage = perMessage(l1dMisses.stop()),
+                    .cacheMissesPerMessage = perMessage(cacheMisses.stop()) };
+}
+
+void print(std::string_view name, Result const& result)
+{
+    auto const printCount = [](std::optional<double> count) {
+        if (count)
+            std::cout << std::setw(18) << std::fixed << std::setprecision(3) << *count;
+        else
+            std::cout << std::setw(18) << "n/a";
+    };
+
+    std::cout << std::setw(24) << name << std::setw(12) << std::fixed << std::setprecision(1)
+              << result.nanosecondsPerMessage;
+    printCount(result.l1dMissesPerMessage);
+    printCount(result.cacheMissesPerMessage);
+    std::cout << '\n';
+}
+
+} // namespace
+
+int main(int argc, char const* argv[])
+{
+    auto const messageCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000ULL;
+
+    std::cout << std::setw(24) << "channel" << std::setw(12) << "ns/msg" << std::setw(18) << "L1D misses/msg"
+              << std::setw(18) << "cache misses/msg" << '\n';
+
+    print("Channel", measure<channel::Channel<int>, 1>(messageCount));
+    print("Channel x2 adjacent", measure<channel::Channel<int>, 2>(messageCount));
+    print("SpscChannel", measure<channel::SpscChannel<int>, 1>(messageCount));
+    print("SpscChannel x2 adjacent", measure<channel::SpscChannel<int>, 2>(messageCount));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Measures the throughput of many producers fanning into a single consumer,
+// comparing the lock-free actor::Mailbox with the previous mutex + deque inbox.
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <actor/mailbox.hpp>
+
+namespace
+{
+
+/// The inbox as implemented before the lock-free mailbox: one mutex, a deque and a notify per message.
+template <typename T>
+class LockedMailbox
+{
+  public:
+    void push(T&& value)
+    {
+        auto _ = std::unique_lock { _lock };
+        _queue.emplace_back(std::move(value));
+        _condition.notify_one();
+    }
+
+    std::optional<T> pop()
+    {
+        auto lock = std::unique_lock { _lock };
+        _condition.wait(lock, [this]() { return !_queue.empty(); });
+        auto value = std::move(_queue.front());
+        _queue.pop_front();
+        return value;
+    }
+
+  private:
+    std::deque<T> _queue;
+    std::condition_variable _condition;
+    std::mutex _lock;
+};
+
+template <typename MailboxType>
+double measure(size_t producerCount, size_t messageCount)
+{
+    auto mailbox = MailboxType {};
+    auto const perProducer = messageCount / producerCount;
+    auto const total = perProducer * producerCount;
+
+    auto const start = std::chrono::steady_clock::now();
+
+    auto producers = std::vector<std::thread> {};
+    for (size_t p = 0; p < producerCount; ++p)
+        producers.emplace_back([&mailbox, perProducer]() {
+            for (size_t i = 0; i < perProducer; ++i)
+                mailbox.push(static_cast<int>(i));
+        });
+
+    for (size_t i = 0; i < total; ++i)
+        (void) mailbox.pop();
+
+    auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (auto& producer: producers)
+        producer.join();
+
+    return static_cast<double>(total) / elapsed;
+}
+
+} // namespace
+
+int main(int argc, char const* argv[])
+{
+    auto const messageCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000ULL;
+
+    std::cout << std::setw(10) << "producers" << std::setw(20) << "locked (msg/s)" << std::setw(20)
+              << "lock-free (msg/s)" << std::setw(10) << "speedup" << '\n';
+
+    for (size_t const producerCount: { 1, 4, 16, 64 })
+    {
+        auto const locked = measure<LockedMailbox<int>>(producerCount, messageCount);
+        auto const lockFree = measure<actor::Mailbox<int>>(producerCount, messageCount);
+        std::cout << std::setw(10) << producerCount << std::setw(20) << std::fixed << std::setprecision(0) << locked
+                  << std::setw(20) << lockFree << std::setw(9) << std::setprecision(2) << (lockFree / locked) << "x\n";
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Measures the per-message hand-off cost between one sending and one receiving thread,
+// comparing the mutex based Channel with the lock-free SpscChannel.
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include <actor/spsc_channel.hpp>
+
+namespace
+{
+
+template <typename ChannelType>
+double nanosecondsPerMessage(size_t capacity, size_t messageCount)
+{
+    auto controller = channel::Controller {};
+    auto channel = ChannelType { channel::MessageBufferSize { capacity }, &controller };
+
+    auto const start = std::chrono::steady_clock::now();
+
+    auto sender = std::thread { [&]() {
+        for (size_t i = 0; i < messageCount; ++i)
+            channel.send(static_cast<int>(i));
+        channel.close();
+    } };
+
+    while (channel.receive())
+        ;
+
+    auto const elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    sender.join();
+
+    return elapsed / static_cast<double>(messageCount);
+}
+
+} // namespace
+
+int main(int argc, char const* argv[])
+{
+    auto const messageCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000ULL;
+
+    std::cout << std::setw(10) << "capacity" << std::setw(24) << "Channel (ns/msg)" << std::setw(24)
+              << "SpscChannel (ns/msg)" << '\n';
+
+    for (size_t const capacity: { 1, 64, 1024 })
+        std::cout << std::setw(10) << capacity << std::setw(24) << std::fixed << std::setprecision(1)
+                  << nanosecondsPerMessage<channel::Channel<int>>(capacity, messageCount) << std::setw(24)
+                  << nanosecondsPerMessage<channel::SpscChannel<int>>(capacity, messageCount) << '\n';
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Measures the latency from sending a message until the receiving thread has it, for each receiver WaitStrategy,
+// with messages sent back to back and paced 10 µs and 100 µs apart. Between paced messages the receiver runs out
+// of work, so its latency includes the cost of waking it up, which is what the strategies trade CPU time against.
+//
+// Usage: wait-strategy-bench [MESSAGES]
+//
+// The sender paces messages by yielding until the next one is due, so that the receiver is not starved of a CPU
+// on small machines. With a single CPU, spinning receivers yield instead, and the numbers mostly show scheduling.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+#include <actor/actor.hpp>
+#include <actor/metrics.hpp>
+#include <actor/spsc_channel.hpp>
+#include <actor/wait_strategy.hpp>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+int64_t now() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+/// Calls @p send with the current time @p messageCount times, @p interval apart.
+template <typename Send>
+void sendPaced(Send&& send, size_t messageCount, std::chrono::nanoseconds interval)
+{
+    auto next = Clock::now();
+    for (size_t i = 0; i < messageCount; ++i)
+    {
+        while (Clock::now() < next)
+            std::this_thread::yield();
+        send(now());
+        next += interval;
+    }
+}
+
+template <typename ChannelType>
+actor::LatencySummary channelLatency(actor::WaitStrategy strategy,
+                                     size_t messageCount,
+                                     std::chrono::nanoseconds interval)
+{
+    auto channel = ChannelType { channel::MessageBufferSize { 1024 } };
+    channel.set_wait_strategy(strategy);
+    auto latencies = actor::LatencyHistogram {};
+    auto receiver = std::thread { [&]() {
+        while (auto sentAt = channel.receive())
+            latencies.record(std::chrono::nanoseconds { now() - *sentAt });
+    } };
+
+    sendPaced([&](int64_t sentAt) { channel.send(sentAt); }, messageCount, interval);
+    channel.close();
+    receiver.join();
+    return latencies.summary();
+}
+
+actor::LatencySummary actorLatency(actor::WaitStrategy strategy, size_t messageCount, std::chrono::nanoseconds interval)
+{
+    auto latencies = actor::LatencyHistogram {};
+    {
+        auto target = actor::Actor(
+            [&](actor::Receiver receiver) {
+                for (actor::Message& message: receiver)
+                    message.match<int64_t>(
+                        [&](int64_t sentAt) { latencies.record(std::chrono::nanoseconds { now() - sentAt }); });
+            },
+            actor::MailboxOptions { .wait = strategy });
+        sendPaced([&](int64_t sentAt) { target << sentAt; }, messageCount, interval);
+    }
+    return latencies.summary();
+}
+
+void print(std::string_view queue,
+           std::string_view strategy,
+           std::chrono::nanoseconds interval,
+           actor::LatencySummary const& latency)
+{
+    std::cout << std::setw(12) << queue << std::setw(16) << strategy << std::setw(14) << interval.count()
+              << std::setw(12) << latency.p50.count() << std::setw(12) << latency.p99.count() << std::setw(12)
+              << latency.max.count() << '\n';
+}
+
+} // namespace
+
+int main(int argc, char const* argv[])
+{
+    auto const messageCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000ULL;
+
+    struct NamedStrategy
+    {
+        std::string_view name;
+        actor::WaitStrategy strategy;
+    };
+    auto const strategies = { NamedStrategy { "park", actor::WaitStrategy::park() },
+                              NamedStrategy { "spin_then_park", actor::WaitStrategy::spin_then_park() },
+                              NamedStrategy { "adaptive", actor::WaitStrategy::adaptive() },
+                              NamedStrategy { "busy_spin", actor::WaitStrategy::busy_spin() } };
+
+    std::cout << std::setw(12) << "queue" << std::setw(16) << "strategy" << std::setw(14) << "interval (ns)"
+              << std::setw(12) << "p50 (ns)" << std::setw(12) << "p99 (ns)" << std::setw(12) << "max (ns)" << '\n';
+
+    using namespace std::chrono_literals;
+    for (auto const interval: { std::chrono::nanoseconds { 0 }, std::chrono::nanoseconds { 10us },
+                                std::chrono::nanoseconds { 100us } })
+    {
+        for (auto const& [name, strategy]: strategies)
+        {
+            print("Channel", name, interval,
+                  channelLatency<channel::Channel<int64_t>>(strategy, messageCount, interval));
+            print("SpscChannel", name, interval,
+                  channelLatency<channel::SpscChannel<int64_t>>(strategy, messageCount, interval));
+            print("Actor", name, interval, actorLatency(strategy, messageCount, interval));
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Measures the throughput of one producer distributing work items among 1..32 competing worker threads,
+// comparing Channel (FIFO wakeups through the controller's wait queues) with WorkQueue (direct hand-off to the
+// most recently idle worker).
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <actor/work_queue.hpp>
+
+namespace
+{
+
+constexpr auto BufferSize = channel::MessageBufferSize { 1024 };
+
+/// Simulates a small amount of work per item, so that workers actually go idle and compete.
+void work(int item, std::atomic<long>& sink)
+{
+    auto value = static_cast<long>(item);
+    for (int i = 0; i < 100; ++i)
+        value = value * 31 + i;
+    sink.fetch_add(value & 1, std::memory_order_relaxed);
+}
+
+template <typename Queue>
+double millionItemsPerSecond(size_t workerCount, size_t itemCount)
+{
+    auto queue = Queue { BufferSize };
+    auto sink = std::atomic<long> { 0 };
+
+    auto const start = std::chrono::steady_clock::now();
+
+    auto workers = std::vector<std::thread> {};
+    for (size_t i = 0; i < workerCount; ++i)
+        workers.emplace_back([&]() {
+            while (auto item = queue.receive())
+                work(*item, sink);
+        });
+
+    for (size_t i = 0; i < itemCount; ++i)
+        queue.send(static_cast<int>(i));
+    queue.close();
+
+    for (auto& worker: workers)
+        worker.join();
+
+    auto const elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(itemCount) / elapsed;
+}
+
+} // namespace
+
+int main(int argc, char const* argv[])
+{
+    auto const itemCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000ULL;
+
+    std::cout << std::setw(10) << "workers" << std::setw(24) << "Channel (M items/s)" << std::setw(24)
+              << "WorkQueue (M items/s)" << '\n';
+
+    for (size_t const workerCount: { 1, 2, 4, 8, 16, 32 })
+        std::cout << std::setw(10) << workerCount << std::setw(24) << std::fixed << std::setprecision(2)
+                  << millionItemsPerSecond<channel::Channel<int>>(workerCount, itemCount) << std::setw(24)
+                  << millionItemsPerSecond<channel::WorkQueue<int>>(workerCount, itemCount) << '\n';
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <actor/channel.hpp>
+#include <actor/coroutine_actor.hpp>
+#include <actor/task.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <latch>
+
+// Runs tens of thousands of channel consumers as coroutines on a handful of threads.
+
+namespace
+{
+
+constexpr int ConsumerCount = 10'000;
+constexpr int MessageCount = 1'000'000;
+
+actor::Task<> consume(channel::Channel<int>& channel, std::atomic<long>& sum, std::latch& done)
+{
+    while (auto value = co_await channel.async_receive())
+        sum += *value;
+    done.count_down();
+}
+
+} // namespace
+
+int main()
+{
+    auto executor = actor::Executor {};
+    auto controller = channel::Controller {};
+    auto numbers = channel::Channel<int> { channel::MessageBufferSize { 256 }, &controller };
+    auto sum = std::atomic<long> { 0 };
+    auto done = std::latch { ConsumerCount };
+
+    for (int i = 0; i < ConsumerCount; ++i)
+        actor::spawn(executor, consume(numbers, sum, done));
+
+    {
+        auto producer = actor::CoroutineActor { executor, [&](actor::Message& message) -> actor::Task<> {
+                                                   auto const count = message.get<int>();
+                                                   for (int i = 1; i <= count; ++i)
+                                                       co_await numbers.async_send(i);
+                                               } };
+        producer << MessageCount;
+    }
+
+    numbers.close();
+    done.wait();
+
+    std::cout << "Workers: " << executor.workerCount() << '\n';
+    std::cout << "Consumers: " << ConsumerCount << '\n';
+    std::cout << "Sum: " << sum.load() << " (expected " << long { MessageCount } * (MessageCount + 1) / 2 << ")\n";
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+
+#include <actor/actor.hpp>
+
+int main()
+{
+    constexpr int ActorCount = 10'000;
+    constexpr int MessagesPerActor = 10;
+
+    auto executor = actor::Executor {};
+    auto received = std::atomic<int> { 0 };
+
+    // Ten thousand actors sharing a handful of worker threads.
+    auto actors = std::list<actor::Actor> {};
+    for (int i = 0; i < ActorCount; ++i)
+        actors.emplace_back(executor, [&](actor::Message& mesg) {
+            mesg.match<int>([&](int) { ++received; });
+        });
+
+    for (int n = 0; n < MessagesPerActor; ++n)
+        for (auto& a: actors)
+            a << n;
+
+    actors.clear();
+
+    std::cout << "Workers: " << executor.workerCount() << '\n';
+    std::cout << "Received " << received.load() << " of " << ActorCount * MessagesPerActor << " messages.\n";
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <actor/typed_actor.hpp>
+
+int main()
+{
+    auto logger = actor::TypedActor<std::string, int, float, bool> { actor::overloaded {
+        [](std::string const& s) { std::cout << "LOG(str): " << s << '\n'; },
+        [](int val) { std::cout << "LOG(num): " << val << '\n'; },
+        [](float val) { std::cout << "LOG(float): " << val << '\n'; },
+        [](bool val) { std::cout << "LOG(bool): " << std::boolalpha << val << '\n'; },
+    } };
+
+    logger << std::string("Hello, World");
+    logger << 42;
+    logger << true;
+    logger << 3.14F;
+    // logger << 2.81; // does not compile: double is not one of the actor's message types
+
+    return EXIT_SUCCESS;
+}
@@ -1,47 +1,119 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
-#include <any>
-#include <atomic>
+#include <actor/actor_core.hpp>
+#include <actor/executor.hpp>
+
+#include <any> // std::bad_any_cast
+#include <chrono>
 #include <concepts>
-#include <condition_variable>
-#include <deque>
+#include <cstddef>
 #include <functional>
-#include <mutex>
+#include <memory>
 #include <optional>
-#include <thread>
+#include <ranges>
+#include <type_traits>
+#include <utility>
 
 namespace actor
 {
 
+namespace detail
+{
+    /// Deliberately not const: identical read-only constants may be merged by the compiler or linker (e.g.
+    /// -fmerge-all-constants, identical code folding), which would give distinct types the same identity.
+    template <typename T>
+    inline char typeIdTag;
+
+    /// Identifies a type by the address of a per-type variable, which is cheaper to compare than std::type_info.
+    using TypeId = void const*;
+
+    template <typename T>
+    constexpr TypeId type_id() noexcept
+    {
+        return &typeIdTag<std::remove_cvref_t<T>>;
+    }
+
+    /// Invokes @p f with @p value moved, or as lvalue reference if @p f does not accept an rvalue.
+    template <typename F, typename T>
+    decltype(auto) invoke_consuming(F& f, T& value)
+    {
+        if constexpr (std::invocable<F&, T&&>)
+            return f(std::move(value));
+        else
+            return f(value);
+    }
+} // namespace detail
+
 /// A message that can be sent to an actor.
+///
+/// Values of up to InlineSize bytes are stored inline, larger ones on the heap.
+/// Handlers passed to match() and expect() receive the value moved out of the message
+/// (or by lvalue reference if they take a non-const reference), so no copies are made.
 class Message
 {
   public:
+    /// The maximum size of values that are stored without a heap allocation.
+    static constexpr size_t InlineSize = 48;
+
     template <typename T>
         requires(!std::same_as<std::decay_t<T>, Message>)
-    Message(T&& val):
-        _value { std::forward<T>(val) }
+    Message(T&& val)
     {
+        using Value = std::decay_t<T>;
+        if constexpr (Model<Value>::Inline)
+            std::construct_at(reinterpret_cast<Value*>(_storage), std::forward<T>(val));
+        else
+            std::construct_at(reinterpret_cast<Value**>(_storage), new Value(std::forward<T>(val)));
+        _operations = &Model<Value>::operations;
     }
 
     Message() = default;
-    Message(Message&&) = default;
+
+    Message(Message&& other) noexcept:
+        _matched { other._matched }
+    {
+        if (other._operations)
+            other._operations->move(*this, other);
+        _operations = std::exchange(other._operations, nullptr);
+    }
+
+    Message& operator=(Message&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
+        reset();
+        if (other._operations)
+            other._operations->move(*this, other);
+        _operations = std::exchange(other._operations, nullptr);
+        _matched = other._matched;
+        return *this;
+    }
+
     Message(Message const&) = delete;
-    Message& operator=(Message&&) = default;
     Message& operator=(Message const&) = delete;
-    ~Message() = default;
+
+    ~Message()
+    {
+        reset();
+    }
 
     template <typename T>
     [[nodiscard]] bool is() const noexcept
     {
-        return typeid(T) == _value.type();
+        return _operations && _operations->type == detail::type_id<T>();
     }
 
+    /// Retrieves a reference to the underlying value.
+    ///
+    /// @throw std::bad_any_cast if the underlying value is not of type @p T.
     template <typename T>
-    decltype(auto) get()
+    std::remove_cvref_t<T>& get()
     {
-        return std::any_cast<T>(_value);
+        if (!is<T>())
+            throw std::bad_any_cast {};
+        return *Model<std::remove_cvref_t<T>>::pointer(*this);
     }
 
     /// Tests if underlying value is of type @p T and invokes @p f if so.
@@ -51,7 +123,7 @@ class Message
         if (is<T>() && !_matched)
         {
             _matched = true;
-            f(get<T>());
+            detail::invoke_consuming(f, get<T>());
         }
 
         return *this;
@@ -67,36 +139,106 @@ class Message
 
     /// Expects given type @p T and invokes handler function @p f on underlying value.
     ///
-    /// @throw std::bad_any_cast as get<T>() throws because of std::any_cast<T>().
+    /// @throw std::bad_any_cast as get<T>() throws if the underlying value is not of type @p T.
     template <typename T, typename U>
     void expect(U f)
     {
-        f(get<T>());
+        detail::invoke_consuming(f, get<T>());
     }
 
-    // TODO: add Visitor pattern
-    // message.visit(Vistor{ .... });
-
   private:
-    std::any _value;
+    /// Type-erased operations on the stored value.
+    struct Operations
+    {
+        detail::TypeId type;
+        void (*move)(Message& target, Message& source) noexcept;
+        void (*destroy)(Message& message) noexcept;
+    };
+
+    template <typename T>
+    struct Model
+    {
+        static constexpr bool Inline = sizeof(T) <= InlineSize && alignof(T) <= alignof(std::max_align_t)
+                                       && std::is_nothrow_move_constructible_v<T>;
+
+        static T* pointer(Message& message) noexcept
+        {
+            if constexpr (Inline)
+                return std::launder(reinterpret_cast<T*>(message._storage));
+            else
+                return *std::launder(reinterpret_cast<T**>(message._storage));
+        }
+
+        static void move(Message& target, Message& source) noexcept
+        {
+            if constexpr (Inline)
+            {
+                std::construct_at(reinterpret_cast<T*>(target._storage), std::move(*pointer(source)));
+                std::destroy_at(pointer(source));
+            }
+            else
+                std::construct_at(reinterpret_cast<T**>(target._storage), pointer(source));
+        }
+
+        static void destroy(Message& message) noexcept
+        {
+            if constexpr (Inline)
+                std::destroy_at(pointer(message));
+            else
+                delete pointer(message);
+        }
+
+        static constexpr Operations operations { detail::type_id<T>(), &move, &destroy };
+    };
+
+    void reset() noexcept
+    {
+        if (_operations)
+            std::exchange(_operations, nullptr)->destroy(*this);
+    }
+
+    alignas(std::max_align_t) std::byte _storage[InlineSize];
+    Operations const* _operations = nullptr;
     bool _matched = false;
 };
 
-class Actor;
-
 class Receiver
 {
   public:
-    Receiver(Actor& actor):
+    Receiver(detail::ActorCore<Message>& actor):
         _actor { actor }
     {
     }
 
     std::optional<Message> receive();
 
+    /// Receives the next message, blocking for at most @p timeout (on the monotonic clock).
+    ///
+    /// @returns the next message or std::nullopt if the timeout was reached or the actor is being destroyed.
+    template <typename Rep, typename Period>
+    std::optional<Message> receive_for(std::chrono::duration<Rep, Period> timeout)
+    {
+        return _actor.receive_for(timeout);
+    }
+
+    /// Receives the next message, blocking until @p deadline at the latest.
+    ///
+    /// @returns the next message or std::nullopt if the deadline was reached or the actor is being destroyed.
+    template <typename Clock, typename Duration>
+    std::optional<Message> receive_until(std::chrono::time_point<Clock, Duration> deadline)
+    {
+        return _actor.receive_until(deadline);
+    }
+
+    /// Tests whether the actor is being destroyed, telling a timed out receive from the end of the stream.
+    [[nodiscard]] bool killing() const noexcept
+    {
+        return _actor.killing();
+    }
+
     struct iterator
     {
-        Actor& _actor;
+        detail::ActorCore<Message>& _actor;
         Message _value;
         bool _eos = false;
 
@@ -127,91 +269,68 @@ class Receiver
     iterator end();
 
   private:
-    Actor& _actor;
+    detail::ActorCore<Message>& _actor;
 };
 
 /// An actor that can receive messages.
 ///
 /// An actor is a lightweight object that can receive messages and process them in a separate thread.
 /// The actor is created with a handler function that is invoked in the actor's thread.
-class Actor
+///
+/// Alternatively, an actor can be bound to an Executor, in which case it does not own a thread.
+/// It is then scheduled onto one of the executor's workers only while its inbox is non-empty,
+/// and its handler is invoked once per message.
+///
+/// The inbox is unbounded by default. Pass MailboxOptions to bound it and to choose what happens to messages
+/// sent to a full inbox. Note that with OverflowPolicy::Block, an actor must not send to itself, and
+/// executor-bound senders may stall the executor's workers.
+///
+/// @see TypedActor for actors with a closed set of message types.
+class Actor: public detail::ActorCore<Message>
 {
   public:
     using Handler = std::function<void(Receiver)>;
+    using MessageHandler = std::function<void(Message&)>;
 
+    /// Constructs a thread-backed actor, invoking @p handler in its own thread, placed according to
+    /// @p threadOptions.
+    ///
+    /// @throw as detail::apply() if the thread options cannot be applied.
     template <typename T>
         requires(std::invocable<T, Receiver>)
-    Actor(T&& handler);
+    Actor(T&& handler, MailboxOptions options = {}, ThreadOptions const& threadOptions = {});
+
+    /// Constructs an actor that is scheduled onto @p executor, invoking @p handler for each received message.
+    ///
+    /// @note The executor must outlive the actor.
+    template <typename T>
+        requires(std::invocable<T, Message&>)
+    Actor(Executor& executor, T&& handler, MailboxOptions options = {});
 
     Actor() = delete;
-    Actor(Actor&&) = delete;
-    Actor(Actor const&) = delete;
-    Actor& operator=(Actor&&) = delete;
-    Actor& operator=(Actor const&) = delete;
-    ~Actor();
 
-    void send(Message&& message);
+    using ActorCore::send;
+    using ActorCore::try_send;
     Actor& operator<<(Message&& message);
 
-    [[nodiscard]] bool killing() const noexcept
-    {
-        return _killing.load();
-    }
-
-    std::optional<Message> receive();
-
-  private:
-    void main();
-
-  private:
-    Handler _handler;
-    std::atomic<bool> _killing;
-    std::deque<Message> _inbox;
-    std::thread _thread;
-    std::condition_variable _condition;
-    std::mutex _lock;
+    /// Sends all elements of @p messages to this actor at once, waking it up (or scheduling it) at most once.
+    using ActorCore::send_batch;
 };
 
 template <typename T>
     requires(std::invocable<T, Receiver>)
-inline Actor::Actor(T&& handler):
-    _handler { std::forward<T>(handler) },
-    _killing { false },
-    _inbox {},
-    _thread { std::bind(&Actor::main, this) }
-{
-}
-
-inline Actor::~Actor()
-{
-    _killing.store(true);
-    _condition.notify_one();
-    _thread.join();
-}
-
-inline void Actor::main()
+inline Actor::Actor(T&& handler, MailboxOptions options, ThreadOptions const& threadOptions):
+    ActorCore { [handler = Handler { std::forward<T>(handler) }](ActorCore& core) { handler(Receiver { core }); },
+                options,
+                threadOptions }
 {
-    _handler(Receiver { *this });
 }
 
-inline std::optional<Message> Actor::receive()
-{
-    std::unique_lock lock { _lock };
-    _condition.wait(lock, [this]() { return !_inbox.empty() || _killing.load(); });
-    if (!_inbox.empty())
-    {
-        Message m = std::move(_inbox.front());
-        _inbox.pop_front();
-        return { std::move(m) };
-    }
-    return std::nullopt;
-}
-
-inline void Actor::send(Message&& message)
+template <typename T>
+    requires(std::invocable<T, Message&>)
+inline Actor::Actor(Executor& executor, T&& handler, MailboxOptions options):
+    ActorCore { executor, MessageHandler { std::forward<T>(handler) }, options }
 {
-    std::unique_lock lock { _lock };
-    _inbox.emplace_back(std::move(message));
-    _condition.notify_one();
 }
 
 inline Actor& Actor::operator<<(Message&& message)
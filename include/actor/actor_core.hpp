@@ -0,0 +1,264 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <actor/executor.hpp>
+#include <actor/mailbox.hpp>
+#include <actor/thread_options.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <utility>
+
+namespace actor::detail
+{
+
+/// The message-type independent machinery shared by all actor types.
+///
+/// Owns the inbox and runs the actor either in its own thread or, when bound to an Executor,
+/// schedules it onto the executor's workers while its inbox is non-empty.
+template <typename M>
+class ActorCore
+{
+  public:
+    using message_type = M;
+
+    /// The maximum number of messages processed per scheduling round of an executor-bound actor
+    /// before yielding the worker to other actors.
+    static constexpr size_t MaxMessagesPerRun = 64;
+
+    ActorCore(ActorCore&&) = delete;
+    ActorCore(ActorCore const&) = delete;
+    ActorCore& operator=(ActorCore&&) = delete;
+    ActorCore& operator=(ActorCore const&) = delete;
+
+    [[nodiscard]] bool killing() const noexcept
+    {
+        return _killing.load();
+    }
+
+    /// Returns the counters of the inbox's overflow handling, which are only non-zero for bounded inboxes.
+    [[nodiscard]] MailboxStatistics mailbox_statistics() const noexcept
+    {
+        return _inbox.statistics();
+    }
+
+    /// Returns a snapshot of the inbox's metrics, which are all zero unless built with ACTOR_METRICS.
+    [[nodiscard]] QueueMetrics metrics() const
+    {
+        return _inbox.metrics();
+    }
+
+    /// Receives the next message, blocking until one is available.
+    ///
+    /// Must only be called from within a thread-backed actor's main function.
+    ///
+    /// @returns the next message or std::nullopt if the actor is being destroyed and its inbox is drained.
+    std::optional<M> receive();
+
+    /// Receives the next message, blocking for at most @p timeout (on the monotonic clock).
+    ///
+    /// Must only be called from within a thread-backed actor's main function.
+    ///
+    /// @returns the next message or std::nullopt if the timeout was reached or the actor is being destroyed
+    ///          and its inbox is drained, which killing() tells apart.
+    template <typename Rep, typename Period>
+    std::optional<M> receive_for(std::chrono::duration<Rep, Period> timeout)
+    {
+        return receive_until(std::chrono::steady_clock::now() + timeout);
+    }
+
+    /// Receives the next message, blocking until @p deadline at the latest.
+    ///
+    /// Must only be called from within a thread-backed actor's main function.
+    ///
+    /// @returns the next message or std::nullopt if the deadline was reached or the actor is being destroyed
+    ///          and its inbox is drained, which killing() tells apart.
+    template <typename Clock, typename Duration>
+    std::optional<M> receive_until(std::chrono::time_point<Clock, Duration> deadline)
+    {
+        return _inbox.pop_until(deadline);
+    }
+
+  protected:
+    using MainFunction = std::function<void(ActorCore&)>;
+    using MessageHandler = std::function<void(M&)>;
+
+    /// Starts a thread running @p main, placed according to @p threadOptions.
+    ///
+    /// If the thread is placed on a NUMA node, it fills the inbox's node cache first, so that the nodes are
+    /// allocated on that node.
+    ///
+    /// @throw as detail::apply() if the thread options cannot be applied.
+    ActorCore(MainFunction main, MailboxOptions options, ThreadOptions const& threadOptions = {});
+
+    /// Binds to @p executor, invoking @p handler for each received message.
+    ActorCore(Executor& executor, MessageHandler handler, MailboxOptions options);
+
+    /// Waits until all messages have been processed.
+    ~ActorCore();
+
+    /// Sends @p message, applying the inbox's overflow policy if it is full.
+    ///
+    /// Messages of a higher @p priority are delivered ahead of all queued messages of lower priorities.
+    ///
+    /// @returns false if the message was not accepted (see Mailbox::push()).
+    bool send(M&& message, Priority priority = Priority::Normal);
+
+    /// Sends @p message only if the inbox has free space, regardless of its overflow policy.
+    bool try_send(M&& message, Priority priority = Priority::Normal);
+
+    template <BatchOf<M> R>
+    size_t send_batch(R&& messages, Priority priority = Priority::Normal);
+
+  private:
+    /// Adapts the actor to the executor.
+    ///
+    /// This is a member rather than a base class, so that a worker still calling into the actor does not race
+    /// with the vtable pointer being rewritten while the derived actor types are destroyed.
+    struct Task final: Runnable
+    {
+        explicit Task(ActorCore& actor):
+            actor { actor }
+        {
+        }
+
+        void run() override
+        {
+            actor.run();
+        }
+
+        ActorCore& actor;
+    };
+
+    void run();
+    void schedule();
+
+    Task _task { *this };
+    MainFunction _main;
+    MessageHandler _messageHandler;
+    Executor* _executor = nullptr;
+    std::atomic<bool> _scheduled = false;
+    std::atomic<bool> _killing = false;
+    Mailbox<M> _inbox;
+    std::condition_variable _idleCondition;
+    std::mutex _idleLock;
+    std::thread _thread; // Must be last, as it starts running _main upon construction.
+};
+
+// ----------------------------------------------------------------------------
+
+template <typename M>
+ActorCore<M>::ActorCore(MainFunction main, MailboxOptions options, ThreadOptions const& threadOptions):
+    _main { std::move(main) },
+    _inbox { options },
+    _thread { start_thread(threadOptions, [this, preallocate = threadOptions.numaNode.has_value()]() {
+        if (preallocate)
+            _inbox.preallocate();
+        _main(*this);
+    }) }
+{
+}
+
+template <typename M>
+ActorCore<M>::ActorCore(Executor& executor, MessageHandler handler, MailboxOptions options):
+    _messageHandler { std::move(handler) }, _executor { &executor }, _inbox { options }
+{
+}
+
+template <typename M>
+ActorCore<M>::~ActorCore()
+{
+    _killing.store(true);
+
+    if (_executor)
+    {
+        // Let the executor drain the inbox before tearing down.
+        auto lock = std::unique_lock { _idleLock };
+        _idleCondition.wait(lock, [this]() { return !_scheduled.load() && _inbox.empty(); });
+        return;
+    }
+
+    _inbox.close();
+    _thread.join();
+}
+
+template <typename M>
+void ActorCore<M>::run()
+{
+    for (size_t i = 0; i < MaxMessagesPerRun; ++i)
+    {
+        auto message = _inbox.try_pop();
+        if (!message)
+            break;
+
+        _messageHandler(*message);
+    }
+
+    // The idle lock only guards the transition to idle, so that the destructor cannot observe
+    // an idle actor while this function still touches it.
+    auto lock = std::unique_lock { _idleLock };
+    _scheduled.store(false);
+    if (!_inbox.empty() && !_scheduled.exchange(true))
+    {
+        // Stay scheduled, but give other actors on this executor a chance to run first.
+        lock.unlock();
+        _executor->schedule(_task);
+        return;
+    }
+
+    if (_killing.load())
+        _idleCondition.notify_all();
+}
+
+template <typename M>
+std::optional<M> ActorCore<M>::receive()
+{
+    return _inbox.pop();
+}
+
+template <typename M>
+void ActorCore<M>::schedule()
+{
+    if (_executor && !_scheduled.load() && !_scheduled.exchange(true))
+        _executor->schedule(_task);
+}
+
+template <typename M>
+bool ActorCore<M>::send(M&& message, Priority priority)
+{
+    if (!_inbox.push(std::move(message), priority))
+        return false;
+
+    schedule();
+    return true;
+}
+
+template <typename M>
+bool ActorCore<M>::try_send(M&& message, Priority priority)
+{
+    if (!_inbox.try_push(std::move(message), priority))
+        return false;
+
+    schedule();
+    return true;
+}
+
+template <typename M>
+template <BatchOf<M> R>
+size_t ActorCore<M>::send_batch(R&& messages, Priority priority)
+{
+    auto const count = _inbox.push_batch(std::forward<R>(messages), priority);
+    if (count != 0)
+        schedule();
+    return count;
+}
+
+} // namespace actor::detail
@@ -0,0 +1,370 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <actor/channel.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace channel
+{
+
+/// Determines what a BroadcastChannel does when a subscriber falls a full buffer behind the sender.
+enum class SlowSubscriberPolicy
+{
+    /// The sender blocks until the slowest subscriber has caught up.
+    Block,
+    /// The sender overwrites the oldest messages, and a lapped subscriber skips ahead to the oldest one left.
+    Lap,
+};
+
+/// Channel delivering every message to all of its subscribers.
+///
+/// Messages are written once into a single ring buffer of shared, immutable payloads, and each subscriber
+/// reads them through its own cursor, so fanning out to N subscribers neither copies nor reallocates the
+/// payload N times. Subscribers only see messages sent after they subscribed. The buffer lets go of a payload
+/// as soon as the last subscriber has received it (or unsubscribed).
+///
+/// A broadcast channel cannot be used with Controller::select.
+///
+/// @code
+/// auto quotes = channel::BroadcastChannel<Quote> { channel::MessageBufferSize { 1024 } };
+/// auto subscription = quotes.subscribe();
+/// std::thread { [&] { quotes.send(Quote { "ACME", 42.0 }); } }.detach();
+/// while (auto quote = subscription.receive())
+///     std::cout << (*quote)->symbol << '\n';
+/// @endcode
+template <typename T>
+class [[nodiscard]] BroadcastChannel: private detail::ChannelBase
+{
+  public:
+    using value_type = std::shared_ptr<T const>;
+
+    class Subscription;
+
+    /// Constructs a broadcast channel.
+    ///
+    /// @param maxBufferSize The number of messages buffered for the slowest subscriber.
+    /// @param policy What to do when the slowest subscriber falls @p maxBufferSize messages behind.
+    /// @param controller The controller to use for the channel.
+    /// @param name The name of the channel.
+    ///
+    /// @note If no controller is provided, a new (internally owned) controller will be created.
+    /// @throw std::invalid_argument for rendezvous and unbounded buffer sizes.
+    explicit BroadcastChannel(MessageBufferSize maxBufferSize = { 64 },
+                              SlowSubscriberPolicy policy = SlowSubscriberPolicy::Block,
+                              Controller* controller = nullptr,
+                              std::string name = {});
+
+    BroadcastChannel(BroadcastChannel&&) = delete;
+    BroadcastChannel(BroadcastChannel const&) = delete;
+    BroadcastChannel& operator=(BroadcastChannel&&) = delete;
+    BroadcastChannel& operator=(BroadcastChannel const&) = delete;
+
+    /// Closes the channel. All subscriptions must have been destroyed before.
+    ~BroadcastChannel();
+
+    /// Retrieves the controller associated with the channel.
+    [[nodiscard]] Controller const& controller() const noexcept
+    {
+        return *_controller;
+    }
+
+    /// Retrieves the channel name, useful for introspection/debugging purposes.
+    [[nodiscard]] std::string const& name() const noexcept
+    {
+        return _name;
+    }
+
+    /// Returns the number of messages buffered for the slowest subscriber, which is a power of two.
+    [[nodiscard]] size_t capacity() const noexcept
+    {
+        return _slots.size();
+    }
+
+    /// Returns the number of current subscribers.
+    [[nodiscard]] size_t subscribers() const noexcept;
+
+    /// Subscribes to all messages sent from now on.
+    ///
+    /// @note The subscription must not outlive the channel.
+    [[nodiscard]] Subscription subscribe();
+
+    /// Sends @p payload to all current subscribers.
+    ///
+    /// With SlowSubscriberPolicy::Block, the caller will be blocked while the slowest subscriber is a full buffer
+    /// behind. If the channel gets closed meanwhile, the message is discarded.
+    void send(value_type payload);
+
+    /// Sends a payload constructed from @p value to all current subscribers.
+    template <typename U>
+        requires std::constructible_from<T, U>
+    void send(U&& value)
+    {
+        send(std::make_shared<T const>(std::forward<U>(value)));
+    }
+
+    /// Closes the channel. Subscribers receive the messages sent until now, then std::nullopt.
+    void close() noexcept;
+
+  private:
+    /// A buffered message, with the number of subscribers that have yet to receive it.
+    struct Slot
+    {
+        value_type payload;
+        size_t readers = 0;
+    };
+
+    /// Receives the next message for @p subscription, blocking if @p wait is true.
+    std::optional<value_type> receive(Subscription& subscription, bool wait);
+
+    /// Returns the position of the slowest subscriber. The controller's mutex must be held.
+    [[nodiscard]] size_t slowest_cursor() const noexcept;
+
+    void unsubscribe(Subscription& subscription) noexcept;
+
+    std::unique_ptr<Controller> _ownedController;
+    Controller* _controller;
+    SlowSubscriberPolicy _policy;
+    std::vector<Slot> _slots;
+    size_t _mask;
+    size_t _tail = 0; // Number of messages sent so far.
+    Subscription* _subscriptions = nullptr;
+    size_t _subscriberCount = 0;
+    std::atomic<bool> _terminating = false;
+    std::string _name;
+};
+
+/// A subscriber's read cursor into a BroadcastChannel.
+template <typename T>
+class [[nodiscard]] BroadcastChannel<T>::Subscription
+{
+  public:
+    /// Takes over the cursor of @p other, which must not be used afterwards.
+    Subscription(Subscription&& other) noexcept;
+
+    Subscription(Subscription const&) = delete;
+    Subscription& operator=(Subscription&&) = delete;
+    Subscription& operator=(Subscription const&) = delete;
+
+    /// Unsubscribes, unblocking a sender that waits for this subscriber to catch up.
+    ~Subscription()
+    {
+        _channel.unsubscribe(*this);
+    }
+
+    /// Receives the next message, sharing its payload with all other subscribers.
+    ///
+    /// If no message is available, the caller will be blocked until one is.
+    /// If the channel is closed and all messages have been received, std::nullopt will be returned.
+    [[nodiscard]] std::optional<value_type> receive()
+    {
+        return _channel.receive(*this, true);
+    }
+
+    /// Tries to receive a message without blocking, returning std::nullopt if no message is available.
+    [[nodiscard]] std::optional<value_type> try_receive()
+    {
+        return _channel.receive(*this, false);
+    }
+
+    /// Returns the number of messages this subscriber missed by being lapped (see SlowSubscriberPolicy::Lap).
+    [[nodiscard]] size_t missed() const noexcept
+    {
+        auto _ = std::unique_lock { *_channel._controller };
+        return _missed;
+    }
+
+  private:
+    friend class BroadcastChannel;
+
+    /// Links the subscription into @p channel, whose controller's mutex must be held.
+    Subscription(BroadcastChannel& channel, size_t cursor) noexcept:
+        _channel { channel }, _cursor { cursor }, _next { channel._subscriptions }
+    {
+        if (_next)
+            _next->_prev = this;
+        channel._subscriptions = this;
+        ++channel._subscriberCount;
+    }
+
+    BroadcastChannel& _channel;
+    size_t _cursor;      // Number of messages this subscriber has consumed or skipped.
+    size_t _missed = 0;
+    bool _subscribed = true;
+    Subscription* _prev = nullptr;
+    Subscription* _next = nullptr;
+};
+
+// ----------------------------------------------------------------------------
+
+template <typename T>
+BroadcastChannel<T>::BroadcastChannel(MessageBufferSize maxBufferSize,
+                                      SlowSubscriberPolicy policy,
+                                      Controller* controller,
+                                      std::string name):
+    _ownedController { controller ? nullptr : std::make_unique<Controller>() },
+    _controller { controller ? controller : _ownedController.get() },
+    _policy { policy },
+    _name { std::move(name) }
+{
+    if (maxBufferSize.value == MessageBufferSize::rendezvous().value
+        || maxBufferSize.value == MessageBufferSize::unbounded().value)
+        throw std::invalid_argument("BroadcastChannel requires a bounded, non-zero buffer size");
+
+    _slots.resize(detail::ring_capacity<Slot>(maxBufferSize.value));
+    _mask = _slots.size() - 1;
+    _controller->attach(*this);
+}
+
+template <typename T>
+BroadcastChannel<T>::~BroadcastChannel()
+{
+    close();
+    _controller->detach(*this);
+}
+
+template <typename T>
+BroadcastChannel<T>::Subscription::Subscription(Subscription&& other) noexcept:
+    _channel { other._channel }
+{
+    auto _ = std::unique_lock { *_channel._controller };
+    _cursor = other._cursor;
+    _missed = other._missed;
+    _prev = std::exchange(other._prev, nullptr);
+    _next = std::exchange(other._next, nullptr);
+    other._subscribed = false;
+
+    if (_prev)
+        _prev->_next = this;
+    else
+        _channel._subscriptions = this;
+    if (_next)
+        _next->_prev = this;
+}
+
+template <typename T>
+size_t BroadcastChannel<T>::subscribers() const noexcept
+{
+    auto _ = std::unique_lock { *_controller };
+    return _subscriberCount;
+}
+
+template <typename T>
+auto BroadcastChannel<T>::subscribe() -> Subscription
+{
+    auto _ = _controller->acquire();
+    return Subscription { *this, _tail };
+}
+
+template <typename T>
+size_t BroadcastChannel<T>::slowest_cursor() const noexcept
+{
+    auto cursor = _tail;
+    for (auto* subscription = _subscriptions; subscription; subscription = subscription->_next)
+        cursor = std::min(cursor, subscription->_cursor);
+    return cursor;
+}
+
+template <typename T>
+void BroadcastChannel<T>::send(value_type payload)
+{
+    auto lock = _controller->acquire();
+
+    if (_policy == SlowSubscriberPolicy::Block)
+    {
+        auto const hasSpace = [this]() { return _tail - slowest_cursor() < _slots.size(); };
+        _controller->wait(lock, _senders, [&]() { return hasSpace() || _terminating.load(); });
+        if (!hasSpace())
+            return; // The channel was closed while waiting for the slowest subscriber.
+    }
+
+    auto& slot = _slots[_tail & _mask];
+    slot.readers = _subscriberCount;
+    slot.payload = slot.readers != 0 ? std::move(payload) : nullptr;
+    ++_tail;
+    _receivers.notify_all();
+}
+
+template <typename T>
+auto BroadcastChannel<T>::receive(Subscription& subscription, bool wait) -> std::optional<value_type>
+{
+    auto lock = _controller->acquire();
+
+    auto const available = [&]() { return subscription._cursor != _tail; };
+    if (wait)
+        _controller->wait(lock, _receivers, [&]() { return available() || _terminating.load(); });
+
+    if (!available())
+        return std::nullopt;
+
+    if (_tail - subscription._cursor > _slots.size())
+    {
+        // Lapped by the sender: the messages up to the oldest one still buffered are gone.
+        auto const oldest = _tail - _slots.size();
+        subscription._missed += oldest - subscription._cursor;
+        subscription._cursor = oldest;
+    }
+
+    auto& slot = _slots[subscription._cursor & _mask];
+    ++subscription._cursor;
+    auto payload = --slot.readers == 0 ? std::move(slot.payload) : slot.payload;
+
+    if (_policy == SlowSubscriberPolicy::Block && !_senders.empty())
+        _senders.notify_one();
+
+    return payload;
+}
+
+template <typename T>
+void BroadcastChannel<T>::unsubscribe(Subscription& subscription) noexcept
+{
+    auto _ = _controller->acquire();
+    if (!subscription._subscribed)
+        return;
+
+    if (subscription._prev)
+        subscription._prev->_next = subscription._next;
+    else
+        _subscriptions = subscription._next;
+    if (subscription._next)
+        subscription._next->_prev = subscription._prev;
+    --_subscriberCount;
+
+    // Give up the messages this subscriber has not received yet, unless they have been overwritten.
+    auto const oldest = _tail - std::min(_tail, _slots.size());
+    for (auto position = std::max(subscription._cursor, oldest); position != _tail; ++position)
+        if (auto& slot = _slots[position & _mask]; --slot.readers == 0)
+            slot.payload = nullptr;
+
+    _senders.notify_one();
+}
+
+template <typename T>
+void BroadcastChannel<T>::close() noexcept
+{
+    auto _ = _controller->acquire();
+
+    auto const wasClosedBefore = _terminating.exchange(true);
+    if (wasClosedBefore)
+        return;
+
+    if (--_controller->_channelCount == 0)
+        _controller->notify_all_locked(); // wake up selects that wait for the controller to die
+    else
+    {
+        _senders.notify_all();
+        _receivers.notify_all();
+    }
+}
+
+} // namespace channel
@@ -0,0 +1,14 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstddef>
+
+namespace actor
+{
+
+/// Alignment used to keep state written by different threads on distinct cache lines.
+///
+/// A fixed value rather than std::hardware_destructive_interference_size, as the latter is not ABI-stable.
+inline constexpr size_t CacheLineSize = 64;
+
+} // namespace actor
@@ -1,14 +1,35 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include <actor/cache_line.hpp>
+#include <actor/executor.hpp>
+#include <actor/metrics.hpp>
+#include <actor/ring_buffer.hpp>
+#include <actor/segmented_queue.hpp>
+#include <actor/wait_strategy.hpp>
+
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <bit>
+#include <chrono>
+#include <concepts>
 #include <condition_variable>
-#include <deque>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <ranges>
+#include <stdexcept>
 #include <string>
-#include <vector>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
 
 namespace channel
 {
@@ -17,11 +38,607 @@ namespace channel
 struct MessageBufferSize
 {
     size_t value;
+
+    /// No buffer at all: sending completes only once a receiver has taken the value.
+    static constexpr MessageBufferSize rendezvous() noexcept
+    {
+        return { 0 };
+    }
+
+    /// A buffer that grows as needed, so that sending never blocks.
+    static constexpr MessageBufferSize unbounded() noexcept
+    {
+        return { std::numeric_limits<size_t>::max() };
+    }
 };
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class Channel;
 
+template <typename T>
+class SpscChannel;
+
+template <typename T>
+class BroadcastChannel;
+
+class Controller;
+
+namespace detail
+{
+    /// A thread or coroutine blocked on a controller, waiting to be signalled by one of the channels it is
+    /// registered with.
+    ///
+    /// Threads are woken up through the condition variable. Coroutines are not resumed by the signalling thread
+    /// (which holds the controller's mutex), but by scheduling their resumption onto an executor. That happens
+    /// only once per wait, even if several of the coroutine's channels signal it before the resumption runs.
+    ///
+    /// @c signalled is only written with the mutex held, but may be polled without it (see Controller::wait_until).
+    struct Waiter
+    {
+        std::condition_variable condition;
+        std::atomic<bool> signalled = false;
+        actor::Executor* executor = nullptr;
+        actor::Runnable* resumption = nullptr;
+    };
+
+    class ReadyList;
+
+    /// Links a Waiter into a channel's wait queue.
+    ///
+    /// A waiter that waits on multiple channels at once (such as select) uses one node per channel.
+    ///
+    /// On rendezvous channels, a waiting sender or receiver may offer a direct hand-off through its node:
+    /// a sender points to a Handoff, a receiver to the std::optional slot the value is to be moved into.
+    ///
+    /// The nodes of a Selector (see ReadyNode) are signalled one by one, each being moved to its @c readyList.
+    struct WaitNode
+    {
+        Waiter* waiter = nullptr;
+        WaitNode* prev = nullptr;
+        WaitNode* next = nullptr;
+        bool linked = false;
+        void* handoff = nullptr;
+        ReadyList* readyList = nullptr;
+    };
+
+    /// A value offered by a sender that waits on a rendezvous channel for a receiver to take it.
+    template <typename T>
+    struct Handoff
+    {
+        T* value;
+        bool taken = false;
+        [[no_unique_address]] actor::detail::Timestamp offeredAt = actor::detail::QueueRecorder<>::now();
+    };
+
+    /// A node that a Selector keeps registered with one channel across waits.
+    ///
+    /// It is always in exactly one place: the channel's wait queue, the selector's ready list (once the channel
+    /// signalled it), or the list of channels reported by the selector's last wait.
+    struct ReadyNode: WaitNode
+    {
+        ReadyNode* prevReady = nullptr;
+        ReadyNode* nextReady = nullptr;
+        ReadyList* list = nullptr; // The list this node is in, if any.
+    };
+
+    /// Intrusive FIFO of ReadyNodes.
+    ///
+    /// All access must happen while holding the mutex of the owning controller.
+    class ReadyList
+    {
+      public:
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return _first == nullptr;
+        }
+
+        void push_back(ReadyNode& node) noexcept
+        {
+            node.prevReady = _last;
+            node.nextReady = nullptr;
+            node.list = this;
+            if (_last)
+                _last->nextReady = &node;
+            else
+                _first = &node;
+            _last = &node;
+        }
+
+        void remove(ReadyNode& node) noexcept
+        {
+            if (node.list != this)
+                return;
+            if (node.prevReady)
+                node.prevReady->nextReady = node.nextReady;
+            else
+                _first = node.nextReady;
+            if (node.nextReady)
+                node.nextReady->prevReady = node.prevReady;
+            else
+                _last = node.prevReady;
+            node.prevReady = node.nextReady = nullptr;
+            node.list = nullptr;
+        }
+
+        /// Removes and returns the oldest node, or nullptr if the list is empty.
+        [[nodiscard]] ReadyNode* pop_front() noexcept
+        {
+            auto* node = _first;
+            if (node)
+                remove(*node);
+            return node;
+        }
+
+      private:
+        ReadyNode* _first = nullptr;
+        ReadyNode* _last = nullptr;
+    };
+
+    /// Intrusive FIFO of threads waiting on a channel.
+    ///
+    /// All access must happen while holding the mutex of the owning controller.
+    class WaitQueue
+    {
+      public:
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return _first == nullptr;
+        }
+
+        /// Returns the number of waiting threads.
+        ///
+        /// Unlike all other members, this may be called without holding the controller's mutex,
+        /// allowing lock-free channels to skip the lock when nobody waits.
+        [[nodiscard]] size_t waiting() const noexcept
+        {
+            return _waiting.load();
+        }
+
+        void push(WaitNode& node) noexcept
+        {
+            // Lock-free channels publish their state before checking waiting(), and the waiter re-checks
+            // that state after this, so at least one of both sides sees the other.
+            _waiting.store(_waiting.load(std::memory_order_relaxed) + 1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            node.prev = _last;
+            node.next = nullptr;
+            node.linked = true;
+            if (_last)
+                _last->next = &node;
+            else
+                _first = &node;
+            _last = &node;
+        }
+
+        void remove(WaitNode& node) noexcept
+        {
+            if (!node.linked)
+                return;
+            if (node.prev)
+                node.prev->next = node.next;
+            else
+                _first = node.next;
+            if (node.next)
+                node.next->prev = node.prev;
+            else
+                _last = node.prev;
+            node.prev = node.next = nullptr;
+            node.linked = false;
+            _waiting.store(_waiting.load(std::memory_order_relaxed) - 1);
+        }
+
+        /// Wakes up the longest waiting thread that has not been signalled yet.
+        void notify_one() noexcept
+        {
+            for (auto* node = _first; node; node = node->next)
+            {
+                // A selector's nodes stand for different channels, so each of them must be signalled on its own.
+                if (node->waiter->signalled && !node->readyList)
+                    continue;
+                remove(*node);
+                signal(*node);
+                return;
+            }
+        }
+
+        /// Removes @p node and wakes up its waiter.
+        void notify(WaitNode& node) noexcept
+        {
+            remove(node);
+            signal(node);
+        }
+
+        /// Returns the longest waiting node that offers a hand-off, or nullptr if there is none.
+        [[nodiscard]] WaitNode* first_handoff() const noexcept
+        {
+            for (auto* node = _first; node; node = node->next)
+                if (node->handoff)
+                    return node;
+            return nullptr;
+        }
+
+        /// Returns the number of waiting nodes that offer a hand-off.
+        [[nodiscard]] size_t handoff_count() const noexcept
+        {
+            auto count = size_t { 0 };
+            for (auto* node = _first; node; node = node->next)
+                if (node->handoff)
+                    ++count;
+            return count;
+        }
+
+        /// Wakes up all waiting threads.
+        void notify_all() noexcept
+        {
+            while (_first)
+            {
+                auto* node = _first;
+                remove(*node);
+                signal(*node);
+            }
+        }
+
+      private:
+        static void signal(WaitNode& node) noexcept
+        {
+            if (node.readyList)
+                node.readyList->push_back(static_cast<ReadyNode&>(node));
+            signal(*node.waiter);
+        }
+
+        static void signal(Waiter& waiter) noexcept
+        {
+            auto const wasSignalled = waiter.signalled.exchange(true);
+            if (waiter.executor)
+            {
+                // A resumption that is already scheduled must not run twice: the first one may end the coroutine.
+                if (!wasSignalled)
+                    waiter.executor->schedule(*waiter.resumption);
+            }
+            else
+                waiter.condition.notify_one();
+        }
+
+        WaitNode* _first = nullptr;
+        WaitNode* _last = nullptr;
+        std::atomic<size_t> _waiting = 0;
+    };
+
+    /// Suspends a coroutine until an operation on channels of one controller can be completed.
+    ///
+    /// The operation is attempted with the controller's mutex held, first when suspending and then each time
+    /// one of the wait queues signals the coroutine. Only once it completes is the coroutine resumed, so a
+    /// wakeup whose value has been taken by someone else in the meantime merely re-registers the waiter.
+    ///
+    /// The awaiting coroutine must run on an actor::Executor, which is where it will be resumed.
+    template <size_t N>
+    class ChannelAwaiter: private actor::Runnable
+    {
+      public:
+        ChannelAwaiter(ChannelAwaiter const&) = delete;
+        ChannelAwaiter& operator=(ChannelAwaiter const&) = delete;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle);
+
+      protected:
+        /// @param handoff The hand-off offered through the wait queue nodes (see WaitNode), if any.
+        ChannelAwaiter(Controller& controller, std::array<WaitQueue*, N> queues, void* handoff = nullptr) noexcept:
+            _controller { controller }, _queues { queues }, _handoff { handoff }
+        {
+        }
+
+        ~ChannelAwaiter() override = default;
+
+        /// Attempts to complete the operation, with the controller's mutex held.
+        ///
+        /// @returns true if the operation is complete (which includes failing due to closed channels).
+        virtual bool try_complete() = 0;
+
+      private:
+        void run() override;
+
+        Controller& _controller; // Locked through Controller::lock(), which accounts for it in the metrics.
+        std::array<WaitQueue*, N> _queues;
+        void* _handoff;
+        std::array<WaitNode, N> _nodes {};
+        Waiter _waiter;
+        std::coroutine_handle<> _handle;
+    };
+
+    /// The buffer of a Channel: a preallocated ring buffer if bounded, or a segmented queue if unbounded or
+    /// bounded by more than PreallocationLimit bytes. The owner enforces the bound in either case.
+    template <typename T, typename Allocator = std::allocator<T>>
+    class ChannelBuffer
+    {
+      public:
+        /// The largest buffer, in bytes, that is allocated up front. Larger bounds, such as those merely meant
+        /// to be a safety net, should not cost their full memory before it is actually used.
+        static constexpr size_t PreallocationLimit = 64 * 1024;
+
+        explicit ChannelBuffer(MessageBufferSize capacity):
+            _storage { capacity.value > PreallocationLimit / sizeof(T)
+                           ? Storage { std::in_place_type<SegmentedQueue<T, Allocator>> }
+                           : Storage { std::in_place_type<RingBuffer<T, Allocator>>, capacity.value } }
+        {
+        }
+
+        [[nodiscard]] size_t size() const noexcept
+        {
+            return std::visit([](auto const& queue) { return queue.size(); }, _storage);
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return std::visit([](auto const& queue) { return queue.empty(); }, _storage);
+        }
+
+        template <typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            return std::visit([&](auto& queue) -> T& { return queue.emplace_back(std::forward<Args>(args)...); },
+                              _storage);
+        }
+
+        [[nodiscard]] T& front() noexcept
+        {
+            return std::visit([](auto& queue) -> T& { return queue.front(); }, _storage);
+        }
+
+        void pop_front() noexcept
+        {
+            std::visit([](auto& queue) { queue.pop_front(); }, _storage);
+        }
+
+      private:
+        using Storage = std::variant<RingBuffer<T, Allocator>, SegmentedQueue<T, Allocator>>;
+        Storage _storage;
+    };
+
+    /// When each value in a channel's buffer was enqueued, which is only kept track of if metrics are enabled.
+    template <bool Enabled = actor::MetricsEnabled>
+    class EnqueueTimes
+    {
+      public:
+        explicit EnqueueTimes(MessageBufferSize capacity):
+            _times { capacity }
+        {
+        }
+
+        void push()
+        {
+            _times.emplace_back(actor::MetricsClock::now());
+        }
+
+        [[nodiscard]] actor::MetricsClock::time_point pop() noexcept
+        {
+            auto const time = _times.front();
+            _times.pop_front();
+            return time;
+        }
+
+      private:
+        ChannelBuffer<actor::MetricsClock::time_point> _times;
+    };
+
+    template <>
+    class EnqueueTimes<false>
+    {
+      public:
+        explicit EnqueueTimes(MessageBufferSize /*capacity*/) noexcept {}
+
+        void push() noexcept {}
+
+        [[nodiscard]] actor::detail::Timestamp pop() noexcept
+        {
+            return {};
+        }
+    };
+
+    /// The type-independent part of a channel: its wait queues and its link in the controller's channel list.
+    class ChannelBase
+    {
+      protected:
+        ChannelBase() = default;
+
+        WaitQueue _senders;
+        WaitQueue _receivers;
+
+      private:
+        ChannelBase* _prevChannel = nullptr;
+        ChannelBase* _nextChannel = nullptr;
+
+        friend class channel::Controller;
+    };
+} // namespace detail
+
+/// The set of channels found ready by Controller::select, identified by their position in the argument list.
+///
+/// This is a fixed-size bitmask, so reporting readiness never allocates. Iterating yields the indices of the
+/// ready channels in ascending order, each index once regardless of how many values the channel holds.
+template <size_t N>
+class ReadySet
+{
+  public:
+    class iterator
+    {
+      public:
+        using value_type = size_t;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        iterator(ReadySet const* set, size_t index) noexcept:
+            _set { set }, _index { set->next(index) }
+        {
+        }
+
+        size_t operator*() const noexcept
+        {
+            return _index;
+        }
+
+        iterator& operator++() noexcept
+        {
+            _index = _set->next(_index + 1);
+            return *this;
+        }
+
+        iterator operator++(int) noexcept
+        {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(iterator const& rhs) const noexcept
+        {
+            return _index == rhs._index;
+        }
+
+      private:
+        ReadySet const* _set = nullptr;
+        size_t _index = N;
+    };
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return std::ranges::all_of(_words, [](uint64_t word) { return word == 0; });
+    }
+
+    /// Returns the number of ready channels.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        auto count = size_t { 0 };
+        for (auto const word: _words)
+            count += static_cast<size_t>(std::popcount(word));
+        return count;
+    }
+
+    [[nodiscard]] bool contains(size_t index) const noexcept
+    {
+        return index < N && (_words[index / 64] & (uint64_t { 1 } << (index % 64))) != 0;
+    }
+
+    void insert(size_t index) noexcept
+    {
+        _words[index / 64] |= uint64_t { 1 } << (index % 64);
+    }
+
+    void clear() noexcept
+    {
+        _words.fill(0);
+    }
+
+    [[nodiscard]] iterator begin() const noexcept
+    {
+        return iterator { this, 0 };
+    }
+
+    [[nodiscard]] iterator end() const noexcept
+    {
+        return iterator { this, N };
+    }
+
+  private:
+    /// Returns the first index in [index, N) that is set, or N if there is none.
+    [[nodiscard]] size_t next(size_t index) const noexcept
+    {
+        while (index < N)
+        {
+            auto const word = _words[index / 64] >> (index % 64);
+            if (word != 0)
+                return std::min(N, index + static_cast<size_t>(std::countr_zero(word)));
+            index = (index / 64 + 1) * 64;
+        }
+        return N;
+    }
+
+    std::array<uint64_t, (N + 63) / 64> _words {};
+};
+
+/// Satisfied by all channel types that can be multiplexed by Controller::select.
+template <typename C>
+concept SelectableChannel = std::derived_from<C, detail::ChannelBase>;
+
+/// A select case that completes by receiving a value from @p channel.
+///
+/// @see receive_from(), Controller::select_case()
+template <SelectableChannel C>
+struct ReceiveCase
+{
+    using result_type = typename C::value_type;
+
+    C& channel;
+};
+
+/// The result of a completed SendCase.
+struct Sent
+{
+};
+
+namespace detail
+{
+    template <typename C>
+    inline constexpr bool isSpscChannel = false;
+
+    template <typename T>
+    inline constexpr bool isSpscChannel<SpscChannel<T>> = true;
+} // namespace detail
+
+/// Satisfied by channels that a select may send to.
+///
+/// SpscChannel is excluded, as the selecting thread would become a second producer next to its actual sender.
+template <typename C>
+concept SendSelectableChannel = SelectableChannel<C> && !detail::isSpscChannel<C>;
+
+/// A select case that completes by sending @p value to @p channel.
+///
+/// The value is only moved from if this case is the one that completes.
+///
+/// @see send_to(), Controller::select_case()
+template <SendSelectableChannel C, typename U>
+struct SendCase
+{
+    using result_type = Sent;
+
+    C& channel;
+    U&& value;
+};
+
+template <SelectableChannel C>
+ReceiveCase<C> receive_from(C& channel) noexcept
+{
+    return ReceiveCase<C> { channel };
+}
+
+template <SendSelectableChannel C, typename U>
+    requires std::convertible_to<U, typename C::value_type>
+SendCase<C, U> send_to(C& channel, U&& value) noexcept
+{
+    return SendCase<C, U> { channel, std::forward<U>(value) };
+}
+
+namespace detail
+{
+    template <typename T>
+    inline constexpr bool isSelectCase = false;
+
+    template <typename C>
+    inline constexpr bool isSelectCase<ReceiveCase<C>> = true;
+
+    template <typename C, typename U>
+    inline constexpr bool isSelectCase<SendCase<C, U>> = true;
+} // namespace detail
+
+/// Satisfied by ReceiveCase and SendCase.
+template <typename T>
+concept SelectCase = detail::isSelectCase<std::remove_cvref_t<T>>;
+
 /// Thrown when a channel does not belong to the controller that is being used.
 class ControllerMismatchError: public std::runtime_error
 {
@@ -38,18 +655,31 @@ class ControllerMismatchError: public std::runtime_error
 class [[nodiscard]] Controller
 {
   private:
-    std::mutex _mutex;
-    std::condition_variable _condition;
-    std::atomic<size_t> _channelCount = 0;
+    // Written by every thread that takes the mutex, so kept on a cache line of its own.
+    alignas(actor::CacheLineSize) std::mutex _mutex;
+    [[no_unique_address]] actor::detail::ControllerRecorder<> _metrics;
+    detail::ChannelBase* _channels = nullptr;
+    size_t _selectCursor = 0; // Rotating start position of select_case(), guarded by _mutex.
+
+    // Rarely written, and read without the mutex by alive() and terminating().
+    alignas(actor::CacheLineSize) std::atomic<size_t> _channelCount = 0;
     std::atomic<bool> _terminating = false;
 
-    template <typename T>
+    template <typename T, typename Allocator>
     friend class Channel;
 
+    template <typename T>
+    friend class SpscChannel;
+
+    template <typename T>
+    friend class BroadcastChannel;
+
+    friend class Selector;
+
   public:
     void lock()
     {
-        _mutex.lock();
+        _metrics.lock(_mutex);
     }
 
     void unlock()
@@ -57,14 +687,11 @@ class [[nodiscard]] Controller
         _mutex.unlock();
     }
 
-    void notify_one()
-    {
-        _condition.notify_one();
-    }
-
+    /// Wakes up all threads blocked on any channel of this controller.
     void notify_all()
     {
-        _condition.notify_all();
+        auto _ = acquire();
+        notify_all_locked();
     }
 
     [[nodiscard]] bool alive() const noexcept
@@ -79,22 +706,15 @@ class [[nodiscard]] Controller
 
     void terminate() noexcept
     {
+        auto _ = acquire();
         _terminating = true;
-        notify_all();
-    }
-
-    template <typename Predicate>
-    [[nodiscard]] std::unique_lock<std::mutex> lock_wait(Predicate&& pred)
-    {
-        auto lock = std::unique_lock { _mutex };
-        _condition.wait(lock, std::forward<Predicate>(pred));
-        return lock;
+        notify_all_locked();
     }
 
-    template <typename Predicate>
-    void wait(Predicate&& pred)
+    /// Returns a snapshot of the controller's metrics, which are all zero unless built with ACTOR_METRICS.
+    [[nodiscard]] actor::ControllerMetrics metrics() const noexcept
     {
-        _condition.wait(*this, std::forward<Predicate>(pred));
+        return _metrics.snapshot();
     }
 
     template <typename T>
@@ -104,53 +724,243 @@ class [[nodiscard]] Controller
     ///
     /// If no value is available, the caller will be blocked until a value is available.
     ///
-    /// @returns A vector of indices of the channels with available values.
-    template <typename... Ts>
-    std::vector<size_t> select(Channel<Ts>&... channels);
+    /// @returns The set of indices of the channels with available values.
+    ///
+    /// @see Selector for large sets of channels, or sets that change at runtime.
+    template <SelectableChannel... Channels>
+    ReadySet<sizeof...(Channels)> select(Channels&... channels);
 
     /// Selects all channels with available values.
     ///
     /// If no value is available, the caller will be blocked until a value is available for the specified timeout.
     ///
-    /// @returns A vector of indices of the channels with available values or an empty vector if the timeout was
+    /// @returns The set of indices of the channels with available values, which is empty if the timeout was
     /// reached.
-    template <typename... Ts>
-    std::vector<size_t> select_for(std::chrono::milliseconds timeout, Channel<Ts>&... channels);
+    template <SelectableChannel... Channels>
+    ReadySet<sizeof...(Channels)> select_for(std::chrono::milliseconds timeout, Channels&... channels);
 
-    /// Selects all values available from multiple channels.
+    /// Selects all channels with available values and invokes @p callable once for each of them.
     ///
     /// If no value is available, the caller will be blocked until a value is available.
     ///
     /// @retval true If one or more values are available.
     /// @retval false If no value is available.
-    template <typename Callable, typename... Ts>
-        requires(std::invocable<Callable, Channel<Ts>&> || ...)
-    bool select(Callable&& callable, Channel<Ts>&... channels);
+    template <typename Callable, SelectableChannel... Channels>
+        requires(std::invocable<Callable, Channels&> || ...)
+    bool select(Callable&& callable, Channels&... channels);
 
-    /// Selects all values available from multiple channels.
+    /// Selects all channels with available values and invokes @p callable once for each of them.
     ///
     /// If no value is available, the caller will be blocked until a value is available for the specified timeout.
     ///
     /// @retval true If one or more values are available.
     /// @retval false If no value is available.
-    template <typename Callable, typename... Ts>
-        requires(std::invocable<Callable, Channel<Ts>&> || ...)
-    bool select_for(std::chrono::milliseconds timeout, Callable&& callable, Channel<Ts>&... channels);
+    template <typename Callable, SelectableChannel... Channels>
+        requires(std::invocable<Callable, Channels&> || ...)
+    bool select_for(std::chrono::milliseconds timeout, Callable&& callable, Channels&... channels);
+
+    template <SelectableChannel... Channels>
+    class SelectAwaiter;
+
+    /// Selects all channels with available values, suspending the calling coroutine instead of blocking.
+    ///
+    /// The coroutine must run on an actor::Executor.
+    ///
+    /// @code
+    /// for (auto const index: co_await controller.async_select(numbers, words)) { ... }
+    /// @endcode
+    ///
+    /// @returns an awaitable yielding the set of channels with available values, as select() does.
+    template <SelectableChannel... Channels>
+    SelectAwaiter<Channels...> async_select(Channels&... channels);
+
+    /// Receives exactly one value from whichever of the channels has one available.
+    ///
+    /// Selecting and receiving happen under a single acquisition of the controller's mutex, so the value
+    /// cannot be taken by another receiver in between. The channel to start looking at rotates with each call,
+    /// so that busy channels listed first cannot starve the later ones.
+    ///
+    /// If no value is available, the caller will be blocked until one is.
+    ///
+    /// @returns the received value, with the variant's index being the index of the channel it was received from,
+    ///          or std::nullopt if all channels have been closed or the controller is terminating.
+    template <SelectableChannel... Channels>
+    std::optional<std::variant<typename Channels::value_type...>> select_value(Channels&... channels);
+
+    /// Receives exactly one value from whichever of the channels has one available.
+    ///
+    /// Like select_value(), but blocks for at most @p timeout.
+    ///
+    /// @returns the received value, with the variant's index being the index of the channel it was received from,
+    ///          or std::nullopt if the timeout was reached, all channels have been closed or the controller is
+    ///          terminating.
+    template <SelectableChannel... Channels>
+    std::optional<std::variant<typename Channels::value_type...>> select_value_for(std::chrono::milliseconds timeout,
+                                                                                   Channels&... channels);
+
+    /// Completes exactly one of the given receive and send cases, Go-style.
+    ///
+    /// A receive case is ready if its channel has a value, a send case if its channel has free space.
+    /// Waiting, choosing and completing the case happen under a single acquisition of the controller's mutex.
+    /// The case to start looking at rotates with each call, so that load spreads across ready channels.
+    ///
+    /// If no case is ready, the caller will be blocked until one is.
+    ///
+    /// @code
+    /// auto const result = controller.select_case(channel::receive_from(input), channel::send_to(output, value));
+    /// @endcode
+    ///
+    /// @returns the result of the completed case (the received value, or Sent for a send case), with the variant's
+    ///          index being the index of the case, or std::nullopt if all channels have been closed or the
+    ///          controller is terminating.
+    template <SelectCase... Cases>
+    std::optional<std::variant<typename Cases::result_type...>> select_case(Cases... cases);
+
+    /// Completes exactly one of the given receive and send cases.
+    ///
+    /// Like select_case(), but blocks for at most @p timeout.
+    ///
+    /// @returns the result of the completed case, or std::nullopt if the timeout was reached, all channels have
+    ///          been closed or the controller is terminating.
+    template <SelectCase... Cases>
+    std::optional<std::variant<typename Cases::result_type...>> select_case_for(std::chrono::milliseconds timeout,
+                                                                                Cases... cases);
+
+  private:
+    /// Locks the mutex, for waiting on the controller.
+    [[nodiscard]] std::unique_lock<std::mutex> acquire()
+    {
+        lock();
+        return std::unique_lock { _mutex, std::adopt_lock };
+    }
+
+    template <SelectableChannel... Channels>
+    void check_controller(Channels&... channels) const;
+
+    /// Tests whether receiving from @p channel would complete without blocking. The mutex must be held.
+    template <SelectableChannel C>
+    static bool readable(C const& channel) noexcept
+    {
+        return channel.pending() != 0 || channel._terminating.load();
+    }
+
+    static detail::WaitQueue& receivers(detail::ChannelBase& channel) noexcept
+    {
+        return channel._receivers;
+    }
+
+    /// Returns the set of channels with pending values. The mutex must be held.
+    template <SelectableChannel... Channels>
+    static ReadySet<sizeof...(Channels)> collect_ready(Channels&... channels) noexcept;
+
+    /// Invokes @p callable with the channel at @p index through a jump table.
+    template <typename Callable, SelectableChannel... Channels>
+    static void dispatch(size_t index, Callable& callable, Channels&... channels);
+
+    // Per-case operations of select_case(). The mutex must be held.
+    template <typename C>
+    static detail::WaitQueue* wait_queue(ReceiveCase<C> const& c) noexcept
+    {
+        return &c.channel._receivers;
+    }
+
+    template <typename C, typename U>
+    static detail::WaitQueue* wait_queue(SendCase<C, U> const& c) noexcept
+    {
+        return &c.channel._senders;
+    }
+
+    template <typename C>
+    static bool ready(ReceiveCase<C> const& c) noexcept
+    {
+        return c.channel.pending() != 0;
+    }
+
+    template <typename C, typename U>
+    static bool ready(SendCase<C, U> const& c) noexcept
+    {
+        return c.channel.writable();
+    }
+
+    template <typename C>
+    static typename C::value_type complete(ReceiveCase<C>& c)
+    {
+        return c.channel.take_locked();
+    }
+
+    template <typename C, typename U>
+    static Sent complete(SendCase<C, U>& c)
+    {
+        c.channel.put_locked(std::forward<U>(c.value));
+        return Sent {};
+    }
+
+    /// Hands on a wakeup that the select may have consumed without acting upon it.
+    template <SelectCase Case>
+    static void pass_on_wakeup(Case const& c) noexcept
+    {
+        if (ready(c))
+            wait_queue(c)->notify_one();
+    }
 
-    // TODO
-    // template <typename... Ts>
-    // std::optional<std::variant<Ts...>> select_value_for(std::chrono::milliseconds timeout, Ts&&... channels);
+    /// Completes the case at @p index through a jump table.
+    template <SelectCase... Cases>
+    static std::variant<typename Cases::result_type...> complete_at(size_t index, Cases&... cases);
+
+    void attach(detail::ChannelBase& channel) noexcept;
+    void detach(detail::ChannelBase& channel) noexcept;
+    void notify_all_locked() noexcept;
+
+    /// Blocks the calling thread, which must hold @p lock, until @p pred is satisfied or @p deadline is reached.
+    ///
+    /// The thread is registered with each of the given wait queues and is only woken up by them,
+    /// offering @p handoff through its nodes (see detail::WaitNode).
+    ///
+    /// With a @p spinner, the thread first polls for being signalled as its wait strategy says, with the mutex
+    /// released, and only parks on the condition variable if that does not pay off.
+    ///
+    /// @returns the final result of @p pred.
+    template <size_t N, typename Clock, typename Duration, typename Predicate>
+    bool wait_until(std::unique_lock<std::mutex>& lock,
+                    std::array<detail::WaitQueue*, N> const& queues,
+                    std::chrono::time_point<Clock, Duration> deadline,
+                    Predicate&& pred,
+                    void* handoff = nullptr,
+                    actor::detail::Spinner* spinner = nullptr);
+
+    /// Blocks the calling thread, which must hold @p lock, until @p pred is satisfied,
+    /// being woken up only by @p queue.
+    template <typename Predicate>
+    void wait(std::unique_lock<std::mutex>& lock, detail::WaitQueue& queue, Predicate&& pred)
+    {
+        wait_until(lock,
+                   std::array { &queue },
+                   std::chrono::steady_clock::time_point::max(),
+                   std::forward<Predicate>(pred));
+    }
 };
 
 /// Thread-safe channel for sending and receiving messages.
 ///
+/// The buffer size chosen at construction selects the channel's mode:
+/// - A bounded buffer (the default) is preallocated, and senders block while it is full. Buffers larger than
+///   detail::ChannelBuffer::PreallocationLimit bytes grow in fixed-size segments instead, up to the bound.
+/// - MessageBufferSize::unbounded() grows in fixed-size segments, so that sending never blocks.
+/// - MessageBufferSize::rendezvous() has no buffer at all. A send completes only once a receiver has taken
+///   the value, which is moved from the sender straight into the receiver, without an intermediate queue.
+///   On rendezvous channels, select cases do not offer hand-offs themselves: a select waiting to send only
+///   completes against a blocked receive(), and one waiting to receive only against a blocked send().
+///
 /// @code
 /// auto channel = channel::Channel<int> { MessageBufferSize { 1 } };
 /// std::thread { [&channel] { channel.send(42); } }.detach();
 /// std::thread { [&channel] { std::cout << channel.receive().value() << std::endl; } }.detach();
 /// @endcode
-template <typename T>
-class [[nodiscard]] Channel
+///
+/// The buffer is allocated with @p Allocator. With actor::PoolAllocator, an unbounded channel's segments are
+/// recycled through the calling thread's pool rather than the global allocator.
+template <typename T, typename Allocator>
+class [[nodiscard]] Channel: public detail::ChannelBase
 {
     friend class Controller;
 
@@ -159,7 +969,8 @@ class [[nodiscard]] Channel
 
     /// Constructs a channel with a maximum buffer size.
     ///
-    /// @param maxBufferSize The maximum buffer size of the channel.
+    /// @param maxBufferSize The maximum buffer size of the channel, which may also be
+    ///                      MessageBufferSize::rendezvous() or MessageBufferSize::unbounded().
     /// @param controller The controller to use for the channel.
     /// @param name The name of the channel.
     ///
@@ -181,27 +992,104 @@ class [[nodiscard]] Channel
     /// Retrieves the channel name, useful for introspection/debugging purposes.
     [[nodiscard]] std::string const& name() const noexcept;
 
-    /// Returns the maximum buffer size of the channel.
+    /// Returns the maximum buffer size of the channel, which is 0 for rendezvous channels and
+    /// MessageBufferSize::unbounded().value for unbounded ones.
     [[nodiscard]] size_t capacity() const noexcept;
 
     /// Returns true if the channel is empty, false otherwise.
     [[nodiscard]] bool empty() const noexcept;
 
-    /// Returns the current buffer size of the channel.
+    /// Returns the current buffer size of the channel, or the number of blocked senders for rendezvous channels.
     [[nodiscard]] size_t size() const noexcept;
 
     /// Sends a message to the channel.
     ///
     /// If the channel is full, the caller will be blocked until the message can be sent.
+    /// On a rendezvous channel, the caller is blocked until a receiver has taken the message.
+    /// If the channel gets closed while being full, the message is discarded.
     template <typename U>
         requires std::convertible_to<U, T>
     void send(U&& value);
 
-    /// Receives a message from the channel.
+    /// Sends a message to the channel, blocking for at most @p timeout.
     ///
-    /// If the channel is empty, the caller will be blocked until a message is available.
-    /// If the channel is closed, std::nullopt will be returned.
-    [[nodiscard]] std::optional<T> receive();
+    /// Like send(), but gives up once @p timeout has passed on the monotonic clock.
+    ///
+    /// @returns true if the message was sent, false if the timeout was reached or the channel got closed while full.
+    ///          An rvalue @p value of type T is left untouched then.
+    template <typename U, typename Rep, typename Period>
+        requires std::convertible_to<U, T>
+    bool send_for(U&& value, std::chrono::duration<Rep, Period> timeout);
+
+    /// Sends a message to the channel, blocking until @p deadline at the latest.
+    ///
+    /// @returns true if the message was sent, false if the deadline was reached or the channel got closed while full.
+    ///          An rvalue @p value of type T is left untouched then.
+    template <typename U, typename Clock, typename Duration>
+        requires std::convertible_to<U, T>
+    bool send_until(U&& value, std::chrono::time_point<Clock, Duration> deadline);
+
+    /// Sends all messages of @p values to the channel.
+    ///
+    /// Each time the channel has free space, as many messages as fit are moved in at once
+    /// (copied if @p values is an lvalue), waking up receivers only once per such chunk.
+    /// If the channel is full, the caller will be blocked until more messages can be sent.
+    ///
+    /// @returns the number of messages sent, which is less than the number of given values only if the
+    ///          channel got closed.
+    template <std::ranges::input_range R>
+        requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+    size_t send_batch(R&& values);
+
+    /// Receives a message from the channel.
+    ///
+    /// If the channel is empty, the caller will be blocked until a message is available.
+    /// If the channel is closed, std::nullopt will be returned.
+    [[nodiscard]] std::optional<T> receive();
+
+    /// Receives a message from the channel, blocking for at most @p timeout.
+    ///
+    /// Like receive(), but gives up once @p timeout has passed on the monotonic clock.
+    ///
+    /// @returns the received message, or std::nullopt if the timeout was reached or the channel is closed.
+    template <typename Rep, typename Period>
+    [[nodiscard]] std::optional<T> receive_for(std::chrono::duration<Rep, Period> timeout);
+
+    /// Receives a message from the channel, blocking until @p deadline at the latest.
+    ///
+    /// @returns the received message, or std::nullopt if the deadline was reached or the channel is closed.
+    template <typename Clock, typename Duration>
+    [[nodiscard]] std::optional<T> receive_until(std::chrono::time_point<Clock, Duration> deadline);
+
+    class ReceiveAwaiter;
+    class SendAwaiter;
+
+    /// Receives a message from the channel, suspending the calling coroutine instead of blocking.
+    ///
+    /// The coroutine must run on an actor::Executor.
+    ///
+    /// @code
+    /// while (auto value = co_await channel.async_receive()) { ... }
+    /// @endcode
+    ///
+    /// @returns an awaitable yielding the message or std::nullopt if the channel is closed.
+    [[nodiscard]] ReceiveAwaiter async_receive();
+
+    /// Sends a message to the channel, suspending the calling coroutine while the channel is full.
+    ///
+    /// The coroutine must run on an actor::Executor.
+    /// If the channel gets closed while being full, the message is discarded.
+    template <typename U>
+        requires std::convertible_to<U, T>
+    [[nodiscard]] SendAwaiter async_send(U&& value);
+
+    /// Receives up to @p maxCount messages at once, writing them to @p out.
+    ///
+    /// If the channel is empty, the caller will be blocked until a message is available.
+    ///
+    /// @returns the number of messages received, or 0 if the channel is closed.
+    template <std::output_iterator<T> OutputIt>
+    size_t receive_batch(OutputIt out, size_t maxCount);
 
     /// Tries to receive a value without blocking, returning std::nullopt if no value is available.
     [[nodiscard]] std::optional<T> try_receive();
@@ -209,106 +1097,666 @@ class [[nodiscard]] Channel
     /// Closes the channel.
     void close() noexcept;
 
+    /// Returns how receivers wait for a value before parking.
+    [[nodiscard]] actor::WaitStrategy wait_strategy() const noexcept
+    {
+        return _spinner.strategy();
+    }
+
+    /// Sets how receivers wait for a value before parking, which is WaitStrategy::park() by default.
+    /// Must not be called while a receiver waits.
+    void set_wait_strategy(actor::WaitStrategy strategy) noexcept
+    {
+        _spinner = actor::detail::Spinner { strategy };
+    }
+
+    /// Returns a snapshot of the channel's metrics, labelled with its name, which are all zero unless built with
+    /// ACTOR_METRICS. Does not take the controller's mutex.
+    [[nodiscard]] actor::QueueMetrics metrics() const
+    {
+        return _metrics.snapshot(_name);
+    }
+
   private:
-    std::unique_ptr<Controller> _ownedController;
+    [[nodiscard]] bool rendezvous() const noexcept
+    {
+        return _maxBufferSize.value == 0;
+    }
+
+    /// Tests whether the buffer has free space, which a rendezvous channel never has. The mutex must be held.
+    [[nodiscard]] bool has_room() const noexcept
+    {
+        return _queue.size() < _maxBufferSize.value;
+    }
+
+    /// Returns the number of values ready to be received. The controller's mutex must be held.
+    [[nodiscard]] size_t pending() const noexcept
+    {
+        return rendezvous() ? _senders.handoff_count() : _queue.size();
+    }
+
+    /// Tests whether a value can be sent without blocking. The controller's mutex must be held.
+    [[nodiscard]] bool writable() const noexcept
+    {
+        return (rendezvous() ? _receivers.first_handoff() != nullptr : has_room()) && !_terminating.load();
+    }
+
+    /// Takes the oldest value (or the value of the longest blocked sender) and wakes up whoever can make progress
+    /// now. The controller's mutex must be held.
+    [[nodiscard]] T take_locked();
+
+    /// Appends @p value (or moves it into the slot of the longest blocked receiver) and wakes up whoever can make
+    /// progress now. The controller's mutex must be held.
+    template <typename U>
+    void put_locked(U&& value);
+
+    /// Sends @p value, blocking until it has been accepted or @p deadline is reached.
+    /// The controller's mutex must be held by @p lock.
+    ///
+    /// @returns false if the deadline was reached or the channel got closed before that.
+    template <typename U, typename Clock, typename Duration>
+    bool send_locked(std::unique_lock<std::mutex>& lock, U&& value, std::chrono::time_point<Clock, Duration> deadline);
+
+    /// Blocks on @p queue like Controller::wait_until(), accounting the time spent blocked to senders or
+    /// receivers, depending on the queue.
+    template <typename Clock, typename Duration, typename Predicate>
+    bool wait_locked(std::unique_lock<std::mutex>& lock,
+                     detail::WaitQueue& queue,
+                     std::chrono::time_point<Clock, Duration> deadline,
+                     Predicate&& pred,
+                     void* handoff = nullptr);
+
+    /// Accounts for a value appended to the buffer. The controller's mutex must be held.
+    void record_enqueued()
+    {
+        _enqueueTimes.push();
+        _metrics.enqueued(1);
+    }
+
+    /// Accounts for the oldest value taken from the buffer. The controller's mutex must be held.
+    void record_dequeued() noexcept
+    {
+        _metrics.dequeued(_enqueueTimes.pop());
+    }
+
+    // Set up at construction and read on every operation, some of it before taking the mutex, so kept apart from
+    // the state that senders and receivers write. The wait queues of the base class fill the line before.
+    alignas(actor::CacheLineSize) std::unique_ptr<Controller> _ownedController;
     Controller* _controller;
     MessageBufferSize _maxBufferSize;
-    std::deque<T> _queue;
     std::atomic<bool> _terminating = false;
     std::string _name;
+
+    // Written by senders and receivers alike, under the controller's mutex.
+    alignas(actor::CacheLineSize) detail::ChannelBuffer<T, Allocator> _queue;
+    [[no_unique_address]] detail::EnqueueTimes<> _enqueueTimes;
+    [[no_unique_address]] actor::detail::QueueRecorder<> _metrics;
+    actor::detail::Spinner _spinner; // Polled by receivers before parking.
 };
 
 // ----------------------------------------------------------------------------
 
-template <typename T>
-Channel<T>::Channel(MessageBufferSize maxBufferSize, Controller* controller, std::string name):
+template <typename T, typename Allocator>
+Channel<T, Allocator>::Channel(MessageBufferSize maxBufferSize, Controller* controller, std::string name):
     _ownedController { controller ? nullptr : std::make_unique<Controller>() },
     _controller { controller ? controller : _ownedController.get() },
     _maxBufferSize { maxBufferSize },
-    _name { std::move(name) }
+    _name { std::move(name) },
+    _queue { maxBufferSize },
+    _enqueueTimes { maxBufferSize }
 {
-    ++_controller->_channelCount;
+    _controller->attach(*this);
 }
 
-template <typename T>
-Channel<T>::~Channel()
+template <typename T, typename Allocator>
+Channel<T, Allocator>::~Channel()
 {
     close();
+    _controller->detach(*this);
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 template <typename U>
     requires std::convertible_to<U, T>
-void Channel<T>::send(U&& value)
+void Channel<T, Allocator>::send(U&& value)
+{
+    auto lock = _controller->acquire();
+    send_locked(lock, std::forward<U>(value), std::chrono::steady_clock::time_point::max());
+}
+
+template <typename T, typename Allocator>
+template <typename U, typename Rep, typename Period>
+    requires std::convertible_to<U, T>
+bool Channel<T, Allocator>::send_for(U&& value, std::chrono::duration<Rep, Period> timeout)
+{
+    return send_until(std::forward<U>(value), std::chrono::steady_clock::now() + timeout);
+}
+
+template <typename T, typename Allocator>
+template <typename U, typename Clock, typename Duration>
+    requires std::convertible_to<U, T>
+bool Channel<T, Allocator>::send_until(U&& value, std::chrono::time_point<Clock, Duration> deadline)
+{
+    auto lock = _controller->acquire();
+    return send_locked(lock, std::forward<U>(value), deadline);
+}
+
+template <typename T, typename Allocator>
+template <typename U, typename Clock, typename Duration>
+bool Channel<T, Allocator>::send_locked(std::unique_lock<std::mutex>& lock,
+                                        U&& value,
+                                        std::chrono::time_point<Clock, Duration> deadline)
 {
-    auto _ = _controller->lock_wait([this]() { return _queue.size() < _maxBufferSize.value || _terminating.load(); });
+    if (!rendezvous())
+    {
+        wait_locked(lock, _senders, deadline, [this]() { return has_room() || _terminating.load(); });
+
+        if (!has_room())
+            return false; // The deadline was reached or the channel was closed while waiting for free space.
+
+        put_locked(std::forward<U>(value));
+        return true;
+    }
+
+    if (writable())
+    {
+        put_locked(std::forward<U>(value));
+        return true;
+    }
+
+    if (_terminating.load())
+        return false;
+
+    // Offer the value to the next receiver, and wait until it has been taken.
+    auto const offer = [&](T& offered) {
+        auto handoff = detail::Handoff<T> { &offered };
+        _receivers.notify_one(); // Receivers not offering a slot themselves (such as selects) must learn about it.
+        wait_locked(lock, _senders, deadline, [&]() { return handoff.taken || _terminating.load(); }, &handoff);
+        return handoff.taken;
+    };
+
+    if constexpr (std::same_as<U, T>)
+        return offer(value); // Offered in place, so that it is left untouched if it is not taken.
+    else
+    {
+        auto converted = T(std::forward<U>(value));
+        return offer(converted);
+    }
+}
+
+template <typename T, typename Allocator>
+template <typename U>
+void Channel<T, Allocator>::put_locked(U&& value)
+{
+    if (rendezvous())
+    {
+        auto* receiver = _receivers.first_handoff();
+        static_cast<std::optional<T>*>(receiver->handoff)->emplace(std::forward<U>(value));
+        _metrics.enqueued(1);
+        _metrics.dequeued(_metrics.now());
+        _receivers.notify(*receiver);
+        if (writable())
+            _senders.notify_one();
+        return;
+    }
+
     _queue.emplace_back(std::forward<U>(value));
-    _controller->notify_one();
+    record_enqueued();
+    _receivers.notify_one();
+    if (has_room())
+        _senders.notify_one();
 }
 
-template <typename T>
-std::optional<T> Channel<T>::receive()
+template <typename T, typename Allocator>
+template <std::ranges::input_range R>
+    requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+size_t Channel<T, Allocator>::send_batch(R&& values)
+{
+    auto count = size_t { 0 };
+    auto current = std::ranges::begin(values);
+    auto const last = std::ranges::end(values);
+
+    auto const forever = std::chrono::steady_clock::time_point::max();
+    auto lock = _controller->acquire();
+    if (rendezvous())
+    {
+        // Each value needs a receiver of its own.
+        for (; current != last; ++current, ++count)
+        {
+            auto sent = false;
+            if constexpr (std::is_lvalue_reference_v<R>)
+                sent = send_locked(lock, *current, forever);
+            else
+                sent = send_locked(lock, std::ranges::iter_move(current), forever);
+            if (!sent)
+                break;
+        }
+        return count;
+    }
+
+    while (current != last)
+    {
+        wait_locked(lock, _senders, forever, [this]() { return has_room() || _terminating.load(); });
+
+        if (!has_room())
+            break; // The channel was closed while waiting for free space.
+
+        for (; current != last && has_room(); ++current, ++count)
+        {
+            if constexpr (std::is_lvalue_reference_v<R>)
+                _queue.emplace_back(*current);
+            else
+                _queue.emplace_back(std::ranges::iter_move(current));
+            record_enqueued();
+        }
+        _receivers.notify_one();
+    }
+
+    if (has_room())
+        _senders.notify_one();
+
+    return count;
+}
+
+template <typename T, typename Allocator>
+std::optional<T> Channel<T, Allocator>::receive()
 {
-    auto _ = _controller->lock_wait([this]() { return !_queue.empty() || _terminating.load(); });
+    return receive_until(std::chrono::steady_clock::time_point::max());
+}
 
-    if (_queue.empty())
+template <typename T, typename Allocator>
+template <typename Rep, typename Period>
+std::optional<T> Channel<T, Allocator>::receive_for(std::chrono::duration<Rep, Period> timeout)
+{
+    return receive_until(std::chrono::steady_clock::now() + timeout);
+}
+
+template <typename T, typename Allocator>
+template <typename Clock, typename Duration>
+std::optional<T> Channel<T, Allocator>::receive_until(std::chrono::time_point<Clock, Duration> deadline)
+{
+    auto lock = _controller->acquire();
+
+    // On rendezvous channels, offer a slot for a sender to move its value into directly.
+    auto slot = std::optional<T> {};
+    if (rendezvous() && pending() == 0 && !_terminating.load())
+        _senders.notify_one(); // Senders not offering a value themselves (such as selects) must learn about it.
+    wait_locked(lock,
+                _receivers,
+                deadline,
+                [&]() { return slot || pending() != 0 || _terminating.load(); },
+                rendezvous() ? &slot : nullptr);
+
+    if (slot)
+        return slot;
+
+    if (pending() == 0)
         return std::nullopt;
 
+    return take_locked();
+}
+
+template <typename T, typename Allocator>
+T Channel<T, Allocator>::take_locked()
+{
+    if (rendezvous())
+    {
+        auto* sender = _senders.first_handoff();
+        auto& handoff = *static_cast<detail::Handoff<T>*>(sender->handoff);
+        auto value = std::move(*handoff.value);
+        handoff.taken = true;
+        _metrics.enqueued(1);
+        _metrics.dequeued(handoff.offeredAt);
+        _senders.notify(*sender);
+        if (pending() != 0)
+            _receivers.notify_one();
+        return value;
+    }
+
     auto value = std::move(_queue.front());
     _queue.pop_front();
-    _controller->notify_one();
+    record_dequeued();
+    _senders.notify_one();
+    if (!_queue.empty())
+        _receivers.notify_one();
     return value;
 }
 
-template <typename T>
-std::optional<T> Channel<T>::try_receive()
+template <typename T, typename Allocator>
+template <typename Clock, typename Duration, typename Predicate>
+bool Channel<T, Allocator>::wait_locked(std::unique_lock<std::mutex>& lock,
+                                        detail::WaitQueue& queue,
+                                        std::chrono::time_point<Clock, Duration> deadline,
+                                        Predicate&& pred,
+                                        void* handoff)
+{
+    if (pred())
+        return true;
+
+    auto const blockedSince = _metrics.now();
+    auto* spinner = &queue == &_receivers ? &_spinner : nullptr;
+    auto const satisfied = _controller->wait_until(lock, std::array { &queue }, deadline, pred, handoff, spinner);
+    if (&queue == &_senders)
+        _metrics.send_blocked(blockedSince);
+    else
+        _metrics.receive_blocked(blockedSince);
+    return satisfied;
+}
+
+template <typename T, typename Allocator>
+template <std::output_iterator<T> OutputIt>
+size_t Channel<T, Allocator>::receive_batch(OutputIt out, size_t maxCount)
+{
+    auto lock = _controller->acquire();
+    wait_locked(lock,
+                _receivers,
+                std::chrono::steady_clock::time_point::max(),
+                [this]() { return pending() != 0 || _terminating.load(); });
+
+    auto count = size_t { 0 };
+    if (rendezvous())
+    {
+        for (; count < maxCount && pending() != 0; ++count)
+            *out++ = take_locked();
+        return count;
+    }
+
+    for (; count < maxCount && !_queue.empty(); ++count)
+    {
+        *out++ = std::move(_queue.front());
+        _queue.pop_front();
+        record_dequeued();
+    }
+
+    if (count != 0)
+        _senders.notify_one();
+    if (!_queue.empty())
+        _receivers.notify_one();
+
+    return count;
+}
+
+template <typename T, typename Allocator>
+std::optional<T> Channel<T, Allocator>::try_receive()
 {
     auto lock = std::unique_lock { *_controller };
-    if (_queue.empty())
+    if (pending() == 0)
         return std::nullopt;
 
-    auto value = std::move(_queue.front());
-    _queue.pop_front();
-    _controller->notify_one();
-    return value;
+    return take_locked();
 }
 
-template <typename T>
-inline bool Channel<T>::empty() const noexcept
+template <typename T, typename Allocator>
+inline bool Channel<T, Allocator>::empty() const noexcept
 {
     auto _ = std::unique_lock { *_controller };
-    return _queue.empty();
+    return pending() == 0;
 }
 
-template <typename T>
-inline size_t Channel<T>::size() const noexcept
+template <typename T, typename Allocator>
+inline size_t Channel<T, Allocator>::size() const noexcept
 {
     auto _ = std::unique_lock { *_controller };
-    return _queue.size();
+    return pending();
 }
 
-template <typename T>
-inline std::string const& Channel<T>::name() const noexcept
+template <typename T, typename Allocator>
+inline std::string const& Channel<T, Allocator>::name() const noexcept
 {
     return _name;
 }
 
-template <typename T>
-inline size_t Channel<T>::capacity() const noexcept
+template <typename T, typename Allocator>
+inline size_t Channel<T, Allocator>::capacity() const noexcept
 {
     auto _ = std::unique_lock { *_controller };
     return _maxBufferSize.value;
 }
 
-template <typename T>
-inline void Channel<T>::close() noexcept
+template <typename T, typename Allocator>
+inline void Channel<T, Allocator>::close() noexcept
 {
+    auto _ = _controller->acquire();
+
     auto const wasClosedBefore = _terminating.exchange(true);
     if (wasClosedBefore)
         return;
 
-    --_controller->_channelCount;
-    _controller->notify_all();
+    if (--_controller->_channelCount == 0)
+        _controller->notify_all_locked(); // wake up selects that wait for the controller to die
+    else
+    {
+        _senders.notify_all();
+        _receivers.notify_all();
+    }
+}
+
+/// Awaitable returned by Channel::async_receive().
+template <typename T, typename Allocator>
+class [[nodiscard]] Channel<T, Allocator>::ReceiveAwaiter: public detail::ChannelAwaiter<1>
+{
+  public:
+    explicit ReceiveAwaiter(Channel& channel) noexcept:
+        ChannelAwaiter { *channel._controller,
+                         { &channel._receivers },
+                         channel.rendezvous() ? &_value : nullptr },
+        _channel { channel }
+    {
+    }
+
+    std::optional<T> await_resume() noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        return std::move(_value);
+    }
+
+  private:
+    bool try_complete() override
+    {
+        if (!_value && _channel.pending() != 0)
+            _value.emplace(_channel.take_locked());
+        if (_value || _channel._terminating.load())
+            return true;
+
+        if (_channel.rendezvous())
+            _channel._senders.notify_one(); // See receive().
+        return false;
+    }
+
+    Channel& _channel;
+    std::optional<T> _value;
+};
+
+/// Awaitable returned by Channel::async_send().
+template <typename T, typename Allocator>
+class [[nodiscard]] Channel<T, Allocator>::SendAwaiter: public detail::ChannelAwaiter<1>
+{
+  public:
+    template <typename U>
+    SendAwaiter(Channel& channel, U&& value):
+        ChannelAwaiter { *channel._controller,
+                         { &channel._senders },
+                         channel.rendezvous() ? &_handoff : nullptr },
+        _channel { channel },
+        _value { std::forward<U>(value) }
+    {
+    }
+
+    void await_resume() const noexcept {}
+
+  private:
+    bool try_complete() override
+    {
+        if (_handoff.taken)
+            return true;
+
+        if (_channel.rendezvous() ? _channel.writable() : _channel.has_room())
+        {
+            _channel.put_locked(std::move(_value));
+            return true;
+        }
+
+        if (_channel._terminating.load())
+            return true; // The message is discarded if the channel was closed.
+
+        if (_channel.rendezvous())
+            _channel._receivers.notify_one(); // See send_locked().
+        return false;
+    }
+
+    Channel& _channel;
+    T _value;
+    detail::Handoff<T> _handoff { &_value };
+};
+
+template <typename T, typename Allocator>
+auto Channel<T, Allocator>::async_receive() -> ReceiveAwaiter
+{
+    return ReceiveAwaiter { *this };
+}
+
+template <typename T, typename Allocator>
+template <typename U>
+    requires std::convertible_to<U, T>
+auto Channel<T, Allocator>::async_send(U&& value) -> SendAwaiter
+{
+    return SendAwaiter { *this, std::forward<U>(value) };
+}
+
+// ----------------------------------------------------------------------------
+
+template <size_t N>
+bool detail::ChannelAwaiter<N>::await_suspend(std::coroutine_handle<> handle)
+{
+    auto* executor = actor::Executor::current();
+    if (!executor)
+        throw std::logic_error("Channels can only be awaited from coroutines running on an actor::Executor");
+
+    auto _ = std::unique_lock { _controller };
+    if (try_complete())
+        return false;
+
+    _handle = handle;
+    _waiter.executor = executor;
+    _waiter.resumption = this;
+    for (size_t i = 0; i < N; ++i)
+    {
+        _nodes[i].waiter = &_waiter;
+        _nodes[i].handoff = _handoff;
+        _queues[i]->push(_nodes[i]);
+    }
+    return true;
+}
+
+template <size_t N>
+void detail::ChannelAwaiter<N>::run()
+{
+    {
+        auto _ = std::unique_lock { _controller };
+        if (!try_complete())
+        {
+            // Someone else took what we were woken up for. Re-arm the consumed nodes and keep waiting.
+            _waiter.signalled = false;
+            for (size_t i = 0; i < N; ++i)
+                if (!_nodes[i].linked)
+                    _queues[i]->push(_nodes[i]);
+            return;
+        }
+
+        for (size_t i = 0; i < N; ++i)
+            _queues[i]->remove(_nodes[i]);
+    }
+
+    // Must be last, as resuming may destroy this awaiter.
+    _handle.resume();
+}
+
+// ----------------------------------------------------------------------------
+
+inline void Controller::attach(detail::ChannelBase& channel) noexcept
+{
+    auto _ = acquire();
+    channel._nextChannel = _channels;
+    if (_channels)
+        _channels->_prevChannel = &channel;
+    _channels = &channel;
+    ++_channelCount;
+}
+
+inline void Controller::detach(detail::ChannelBase& channel) noexcept
+{
+    auto _ = acquire();
+    if (channel._prevChannel)
+        channel._prevChannel->_nextChannel = channel._nextChannel;
+    else
+        _channels = channel._nextChannel;
+    if (channel._nextChannel)
+        channel._nextChannel->_prevChannel = channel._prevChannel;
+}
+
+inline void Controller::notify_all_locked() noexcept
+{
+    for (auto* channel = _channels; channel; channel = channel->_nextChannel)
+    {
+        channel->_senders.notify_all();
+        channel->_receivers.notify_all();
+    }
+}
+
+template <size_t N, typename Clock, typename Duration, typename Predicate>
+bool Controller::wait_until(std::unique_lock<std::mutex>& lock,
+                            std::array<detail::WaitQueue*, N> const& queues,
+                            std::chrono::time_point<Clock, Duration> deadline,
+                            Predicate&& pred,
+                            void* handoff,
+                            actor::detail::Spinner* spinner)
+{
+    if (pred())
+        return true;
+
+    auto waiter = detail::Waiter {};
+    auto nodes = std::array<detail::WaitNode, N> {};
+    for (size_t i = 0; i < N; ++i)
+    {
+        nodes[i].waiter = &waiter;
+        nodes[i].handoff = handoff;
+        queues[i]->push(nodes[i]);
+    }
+
+    // Senders need the mutex to signal, so release it while polling. The loop below re-checks under the mutex.
+    auto const waitStart = spinner ? spinner->start() : actor::detail::Spinner::Clock::time_point {};
+    auto spun = false;
+    if (spinner && spinner->strategy().mode != actor::WaitStrategy::Mode::Park)
+    {
+        lock.unlock();
+        spun = spinner->spin(waitStart, deadline, [&]() { return waiter.signalled.load(std::memory_order_acquire); });
+        lock.lock();
+    }
+
+    auto satisfied = false;
+    auto wakeups = size_t { 0 };
+    while (!(satisfied = pred()))
+    {
+        if (deadline == std::chrono::time_point<Clock, Duration>::max())
+            waiter.condition.wait(lock, [&]() { return waiter.signalled.load(); });
+        else if (!waiter.condition.wait_until(lock, deadline, [&]() { return waiter.signalled.load(); }))
+            break;
+
+        // Re-arm the nodes that were consumed by the signalling channel(s).
+        ++wakeups;
+        waiter.signalled = false;
+        for (size_t i = 0; i < N; ++i)
+            if (!nodes[i].linked)
+                queues[i]->push(nodes[i]);
+    }
+
+    for (size_t i = 0; i < N; ++i)
+        queues[i]->remove(nodes[i]);
+    if (spinner && !spun)
+        spinner->parked(waitStart);
+
+    // All but the wakeup that satisfied the predicate found nothing to do.
+    _metrics.woken_up(wakeups, satisfied && wakeups != 0 ? wakeups - 1 : wakeups);
+    return satisfied;
 }
 
 // ----------------------------------------------------------------------------
@@ -319,14 +1767,14 @@ inline Channel<T> Controller::channel(MessageBufferSize maxBufferSize, std::stri
     return Channel<T> { maxBufferSize, this, std::move(name) };
 }
 
-template <typename... Ts>
-std::vector<size_t> Controller::select(Channel<Ts>&... channels)
+template <SelectableChannel... Channels>
+ReadySet<sizeof...(Channels)> Controller::select(Channels&... channels)
 {
     return select_for(std::chrono::years { 10 }, channels...);
 }
 
-template <typename... Ts>
-std::vector<size_t> Controller::select_for(std::chrono::milliseconds timeout, Channel<Ts>&... channels)
+template <SelectableChannel... Channels>
+void Controller::check_controller(Channels&... channels) const
 {
     // clang-format off
     (
@@ -337,53 +1785,196 @@ std::vector<size_t> Controller::select_for(std::chrono::milliseconds timeout, Ch
         ...
     );
     // clang-format on
+}
+
+template <SelectableChannel... Channels>
+ReadySet<sizeof...(Channels)> Controller::collect_ready(Channels&... channels) noexcept
+{
+    auto result = ReadySet<sizeof...(Channels)> {};
+    size_t index = 0;
+    // clang-format off
+    (
+        [&] {
+            if (channels.pending() != 0)
+                result.insert(index);
+            ++index;
+        }(),
+        ...
+    );
+    // clang-format on
+    return result;
+}
+
+template <typename Callable, SelectableChannel... Channels>
+void Controller::dispatch(size_t index, Callable& callable, Channels&... channels)
+{
+    using Entry = void (*)(Callable&, Channels&...);
+    static constexpr auto table = []<size_t... I>(std::index_sequence<I...>) {
+        return std::array<Entry, sizeof...(Channels)> { [](Callable& callable, Channels&... channels) {
+            auto& channel = std::get<I>(std::tie(channels...));
+            if constexpr (std::invocable<Callable&, decltype(channel)>)
+                callable(channel);
+        }... };
+    }(std::index_sequence_for<Channels...> {});
+
+    table[index](callable, channels...);
+}
+
+template <SelectCase... Cases>
+std::variant<typename Cases::result_type...> Controller::complete_at(size_t index, Cases&... cases)
+{
+    using Result = std::variant<typename Cases::result_type...>;
+    using Entry = Result (*)(Cases&...);
+    static constexpr auto table = []<size_t... I>(std::index_sequence<I...>) {
+        return std::array<Entry, sizeof...(Cases)> { [](Cases&... cases) {
+            return Result { std::in_place_index<I>, complete(std::get<I>(std::tie(cases...))) };
+        }... };
+    }(std::index_sequence_for<Cases...> {});
+
+    return table[index](cases...);
+}
+
+template <SelectableChannel... Channels>
+std::optional<std::variant<typename Channels::value_type...>> Controller::select_value(Channels&... channels)
+{
+    return select_case(receive_from(channels)...);
+}
+
+template <SelectableChannel... Channels>
+std::optional<std::variant<typename Channels::value_type...>> Controller::select_value_for(
+    std::chrono::milliseconds timeout, Channels&... channels)
+{
+    return select_case_for(timeout, receive_from(channels)...);
+}
+
+template <SelectCase... Cases>
+std::optional<std::variant<typename Cases::result_type...>> Controller::select_case(Cases... cases)
+{
+    return select_case_for(std::chrono::years { 10 }, std::move(cases)...);
+}
 
-    auto result = std::vector<size_t> {};
-    auto const tryFetch = [&]<typename T>(Channel<T>& channel, size_t index) {
-        auto const pending = channel._queue.size();
-        for (size_t i = 0; i < pending; ++i)
-            result.push_back(index);
+template <SelectCase... Cases>
+std::optional<std::variant<typename Cases::result_type...>> Controller::select_case_for(
+    std::chrono::milliseconds timeout, Cases... cases)
+{
+    check_controller(cases.channel...);
+
+    auto readySet = ReadySet<sizeof...(Cases)> {};
+    auto const collect = [&]() {
+        readySet.clear();
+        size_t index = 0;
+        // clang-format off
+        (
+            [&] {
+                if (ready(cases))
+                    readySet.insert(index);
+                ++index;
+            }(),
+            ...
+        );
+        // clang-format on
     };
-    auto lock = std::unique_lock { _mutex };
+
+    auto lock = acquire();
+    if (terminating())
+        return std::nullopt;
+
+    auto const deadline = std::chrono::steady_clock::now() + timeout;
+    wait_until(lock, std::array { wait_queue(cases)... }, deadline, [&] {
+        collect();
+        return !readySet.empty() || !alive() || terminating();
+    });
+
+    if (readySet.empty() || terminating())
+        return std::nullopt;
+
+    auto const start = _selectCursor++ % sizeof...(Cases);
+    for (size_t i = 0; i < sizeof...(Cases); ++i)
+    {
+        auto const index = (start + i) % sizeof...(Cases);
+        if (!readySet.contains(index))
+            continue;
+
+        auto result = complete_at(index, cases...);
+        (pass_on_wakeup(cases), ...);
+        return result;
+    }
+
+    return std::nullopt; // unreachable
+}
+
+template <SelectableChannel... Channels>
+ReadySet<sizeof...(Channels)> Controller::select_for(std::chrono::milliseconds timeout, Channels&... channels)
+{
+    check_controller(channels...);
+
+    auto result = ReadySet<sizeof...(Channels)> {};
+    auto lock = acquire();
     if (!terminating())
     {
-        _condition.wait_for(lock, timeout, [&] {
-            result.clear();
-            size_t index = 0;
-            (tryFetch(channels, index++), ...);
+        auto const deadline = std::chrono::steady_clock::now() + timeout;
+        wait_until(lock, std::array { &channels._receivers... }, deadline, [&] {
+            result = collect_ready(channels...);
             return !result.empty() || !alive() || terminating();
         });
     }
     return result;
 }
 
-template <typename Callable, typename... Ts>
-    requires(std::invocable<Callable, Channel<Ts>&> || ...)
-bool Controller::select(Callable&& callable, Channel<Ts>&... channels)
+/// Awaitable returned by Controller::async_select().
+template <SelectableChannel... Channels>
+class [[nodiscard]] Controller::SelectAwaiter: public detail::ChannelAwaiter<sizeof...(Channels)>
+{
+  public:
+    SelectAwaiter(Controller& controller, Channels&... channels):
+        detail::ChannelAwaiter<sizeof...(Channels)> { controller, { &channels._receivers... } },
+        _controller { controller },
+        _channels { channels... }
+    {
+    }
+
+    ReadySet<sizeof...(Channels)> await_resume() const noexcept
+    {
+        return _result;
+    }
+
+  private:
+    bool try_complete() override
+    {
+        _result.clear();
+        if (_controller.terminating())
+            return true;
+        _result = std::apply([](auto&... channels) { return collect_ready(channels...); }, _channels);
+        return !_result.empty() || !_controller.alive();
+    }
+
+    Controller& _controller;
+    std::tuple<Channels&...> _channels;
+    ReadySet<sizeof...(Channels)> _result;
+};
+
+template <SelectableChannel... Channels>
+auto Controller::async_select(Channels&... channels) -> SelectAwaiter<Channels...>
+{
+    check_controller(channels...);
+    return SelectAwaiter<Channels...> { *this, channels... };
+}
+
+template <typename Callable, SelectableChannel... Channels>
+    requires(std::invocable<Callable, Channels&> || ...)
+bool Controller::select(Callable&& callable, Channels&... channels)
 {
     return select_for(std::chrono::years { 10 }, std::forward<Callable>(callable), channels...);
 }
 
-template <typename Callable, typename... Ts>
-    requires(std::invocable<Callable, Channel<Ts>&> || ...)
-bool Controller::select_for(std::chrono::milliseconds timeout, Callable&& callable, Channel<Ts>&... channels)
+template <typename Callable, SelectableChannel... Channels>
+    requires(std::invocable<Callable, Channels&> || ...)
+bool Controller::select_for(std::chrono::milliseconds timeout, Callable&& callable, Channels&... channels)
 {
     auto const result = select_for(timeout, channels...);
 
     for (auto const index: result)
-    {
-        size_t i = 0;
-        // clang-format off
-        (
-            [&] {
-                if (i == index)
-                    std::forward<Callable>(callable)(channels);
-                ++i;
-            }(),
-            ...
-        );
-        // clang-format on
-    }
+        dispatch(index, callable, channels...);
 
     return !result.empty();
 }
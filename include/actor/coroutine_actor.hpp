@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <actor/actor.hpp>
+#include <actor/executor.hpp>
+#include <actor/mailbox.hpp>
+#include <actor/task.hpp>
+
+#include <concepts>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace actor
+{
+
+/// An actor whose message handler is a coroutine.
+///
+/// The actor runs on an Executor. While its handler is suspended (e.g. awaiting a channel or another task),
+/// the worker thread is free to run other actors, and while its inbox is empty, it occupies no thread at all.
+/// Messages are still processed one at a time, in order: the next message is only dequeued once the handler's
+/// task for the previous one has completed.
+///
+/// @code
+/// auto forwarder = actor::CoroutineActor { executor, [&](actor::Message& message) -> actor::Task<> {
+///     co_await channel.async_send(message.get<int>());
+/// } };
+/// forwarder << 42;
+/// @endcode
+class CoroutineActor
+{
+  public:
+    using Handler = std::function<Task<>(Message&)>;
+
+    /// Constructs an actor that is run on @p executor, awaiting @p handler for each received message.
+    ///
+    /// @note The executor must outlive the actor.
+    template <typename T>
+        requires std::is_invocable_r_v<Task<>, T&, Message&>
+    CoroutineActor(Executor& executor, T&& handler, MailboxOptions options = {});
+
+    CoroutineActor(CoroutineActor&&) = delete;
+    CoroutineActor(CoroutineActor const&) = delete;
+    CoroutineActor& operator=(CoroutineActor&&) = delete;
+    CoroutineActor& operator=(CoroutineActor const&) = delete;
+
+    /// Waits until all messages have been processed.
+    ~CoroutineActor();
+
+    /// Sends @p message, applying the inbox's overflow policy if it is full.
+    ///
+    /// @returns false if the message was not accepted (see Mailbox::push()).
+    bool send(Message&& message, Priority priority = Priority::Normal)
+    {
+        return _inbox.push(std::move(message), priority);
+    }
+
+    /// Sends @p message only if the inbox has free space, regardless of its overflow policy.
+    bool try_send(Message&& message, Priority priority = Priority::Normal)
+    {
+        return _inbox.try_push(std::move(message), priority);
+    }
+
+    /// Sends all elements of @p messages to this actor at once, waking it up at most once.
+    template <BatchOf<Message> R>
+    size_t send_batch(R&& messages, Priority priority = Priority::Normal)
+    {
+        return _inbox.push_batch(std::forward<R>(messages), priority);
+    }
+
+    CoroutineActor& operator<<(Message&& message)
+    {
+        send(std::move(message));
+        return *this;
+    }
+
+    [[nodiscard]] MailboxStatistics mailbox_statistics() const noexcept
+    {
+        return _inbox.statistics();
+    }
+
+    /// Returns a snapshot of the inbox's metrics, which are all zero unless built with ACTOR_METRICS.
+    [[nodiscard]] QueueMetrics metrics() const
+    {
+        return _inbox.metrics();
+    }
+
+  private:
+    Task<> main();
+
+    Handler _handler;
+    Mailbox<Message> _inbox;
+    std::mutex _doneLock;
+    std::condition_variable _doneCondition;
+    bool _done = false;
+};
+
+// ----------------------------------------------------------------------------
+
+template <typename T>
+    requires std::is_invocable_r_v<Task<>, T&, Message&>
+CoroutineActor::CoroutineActor(Executor& executor, T&& handler, MailboxOptions options):
+    _handler { std::forward<T>(handler) }, _inbox { options }
+{
+    spawn(executor, main());
+}
+
+inline CoroutineActor::~CoroutineActor()
+{
+    _inbox.close();
+
+    auto lock = std::unique_lock { _doneLock };
+    _doneCondition.wait(lock, [this]() { return _done; });
+}
+
+inline Task<> CoroutineActor::main()
+{
+    while (auto message = co_await _inbox.async_pop())
+        co_await _handler(*message);
+
+    // Notify while holding the lock, as the actor may be destroyed as soon as it is released.
+    auto _ = std::unique_lock { _doneLock };
+    _done = true;
+    _doneCondition.notify_all();
+}
+
+} // namespace actor
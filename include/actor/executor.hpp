@@ -0,0 +1,228 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <actor/thread_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace actor
+{
+
+/// A unit of work that can be scheduled onto an Executor.
+///
+/// The executor does not take ownership of the runnable; it must outlive its execution.
+class Runnable
+{
+  public:
+    Runnable() = default;
+    Runnable(Runnable&&) = delete;
+    Runnable(Runnable const&) = delete;
+    Runnable& operator=(Runnable&&) = delete;
+    Runnable& operator=(Runnable const&) = delete;
+    virtual ~Runnable() = default;
+
+    virtual void run() = 0;
+};
+
+/// A fixed-size pool of worker threads with work-stealing between the workers.
+///
+/// Each worker owns a local run queue. Work scheduled from within a worker is pushed onto that worker's queue,
+/// work scheduled from outside is distributed round-robin. Idle workers steal from their siblings before parking.
+///
+/// Unlike the usual LIFO discipline of work-stealing deques, workers run their own queue in FIFO order: actors
+/// with more messages pending reschedule themselves after a bounded run, and must go behind the other actors
+/// on the queue rather than monopolize the worker. Thieves take the oldest task as well, which is the one the
+/// victim is least likely to still have in cache, and the one that has waited longest.
+class Executor
+{
+  public:
+    /// Constructs an executor with @p workerCount worker threads (defaults to the number of hardware threads).
+    ///
+    /// All workers are placed according to @p options, so that the actors bound to this executor share the same
+    /// CPUs. A worker's name is suffixed with its index.
+    ///
+    /// @throw as detail::apply() if the options cannot be applied.
+    explicit Executor(size_t workerCount = std::max(1u, std::thread::hardware_concurrency()),
+                      ThreadOptions const& options = {});
+
+    Executor(Executor&&) = delete;
+    Executor(Executor const&) = delete;
+    Executor& operator=(Executor&&) = delete;
+    Executor& operator=(Executor const&) = delete;
+
+    /// Runs all remaining queued work and joins all worker threads.
+    ~Executor();
+
+    /// Schedules @p task to be run on one of the worker threads.
+    void schedule(Runnable& task);
+
+    /// Returns the executor the calling thread is a worker of, or nullptr if it is none.
+    [[nodiscard]] static Executor* current() noexcept
+    {
+        return _currentExecutor;
+    }
+
+    /// Returns the number of worker threads.
+    [[nodiscard]] size_t workerCount() const noexcept
+    {
+        return _workers.size();
+    }
+
+  private:
+    struct Worker
+    {
+        std::mutex lock;
+        std::deque<Runnable*> queue;
+        std::thread thread;
+    };
+
+    void main(size_t index);
+    void shutdown();
+    Runnable* try_pop(size_t index);
+    Runnable* try_steal(size_t index);
+
+    static inline thread_local Executor* _currentExecutor = nullptr;
+    static inline thread_local size_t _currentWorkerIndex = 0;
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::atomic<size_t> _nextWorker = 0;
+    std::atomic<size_t> _pending = 0;
+    std::atomic<size_t> _sleeping = 0;
+    std::atomic<bool> _terminating = false;
+    std::mutex _idleLock;
+    std::condition_variable _idle;
+};
+
+// ----------------------------------------------------------------------------
+
+inline Executor::Executor(size_t workerCount, ThreadOptions const& options)
+{
+    _workers.reserve(std::max<size_t>(1, workerCount));
+    for (size_t i = 0; i < std::max<size_t>(1, workerCount); ++i)
+        _workers.emplace_back(std::make_unique<Worker>());
+
+    try
+    {
+        for (size_t i = 0; i < _workers.size(); ++i)
+        {
+            auto workerOptions = options;
+            if (!options.name.empty())
+            {
+                auto const suffix = '-' + std::to_string(i);
+                workerOptions.name = options.name.substr(0, 15 - std::min<size_t>(15, suffix.size())) + suffix;
+            }
+            _workers[i]->thread = detail::start_thread(workerOptions, [this, i]() { main(i); });
+        }
+    }
+    catch (...)
+    {
+        shutdown();
+        throw;
+    }
+}
+
+inline Executor::~Executor()
+{
+    shutdown();
+}
+
+inline void Executor::shutdown()
+{
+    {
+        auto _ = std::unique_lock { _idleLock };
+        _terminating = true;
+    }
+    _idle.notify_all();
+
+    for (auto& worker: _workers)
+        if (worker->thread.joinable())
+            worker->thread.join();
+}
+
+inline void Executor::schedule(Runnable& task)
+{
+    auto const index =
+        _currentExecutor == this ? _currentWorkerIndex : _nextWorker.fetch_add(1) % _workers.size();
+    ++_pending;
+    {
+        auto& worker = *_workers[index];
+        auto _ = std::unique_lock { worker.lock };
+        worker.queue.push_back(&task);
+    }
+
+    if (_sleeping.load() > 0)
+    {
+        auto _ = std::unique_lock { _idleLock };
+        _idle.notify_one();
+    }
+}
+
+inline Runnable* Executor::try_pop(size_t index)
+{
+    auto& worker = *_workers[index];
+    auto _ = std::unique_lock { worker.lock };
+    if (worker.queue.empty())
+        return nullptr;
+
+    auto* task = worker.queue.front();
+    worker.queue.pop_front();
+    --_pending;
+    return task;
+}
+
+inline Runnable* Executor::try_steal(size_t index)
+{
+    for (size_t i = 1; i < _workers.size(); ++i)
+    {
+        auto& victim = *_workers[(index + i) % _workers.size()];
+        auto _ = std::unique_lock { victim.lock };
+        if (victim.queue.empty())
+            continue;
+
+        auto* task = victim.queue.front();
+        victim.queue.pop_front();
+        --_pending;
+        return task;
+    }
+    return nullptr;
+}
+
+inline void Executor::main(size_t index)
+{
+    _currentExecutor = this;
+    _currentWorkerIndex = index;
+
+    while (true)
+    {
+        if (auto* task = try_pop(index))
+        {
+            task->run();
+            continue;
+        }
+
+        if (auto* task = try_steal(index))
+        {
+            task->run();
+            continue;
+        }
+
+        auto lock = std::unique_lock { _idleLock };
+        ++_sleeping;
+        _idle.wait(lock, [this]() { return _pending.load() > 0 || _terminating.load(); });
+        --_sleeping;
+
+        if (_terminating.load() && _pending.load() == 0)
+            break;
+    }
+}
+
+} // namespace actor
@@ -0,0 +1,830 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <actor/cache_line.hpp>
+#include <actor/executor.hpp>
+#include <actor/metrics.hpp>
+#include <actor/wait_strategy.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace actor
+{
+
+/// Tests whether the elements of range @p R can be enqueued as values of type @p T at once.
+///
+/// Elements are moved out of @p R if it is passed as an rvalue, and copied otherwise.
+template <typename R, typename T>
+concept BatchOf = std::ranges::input_range<R>
+                  && std::constructible_from<T,
+                                             std::conditional_t<std::is_lvalue_reference_v<R>,
+                                                                std::ranges::range_reference_t<R>,
+                                                                std::ranges::range_rvalue_reference_t<R>>>;
+
+/// The delivery priority of a message.
+///
+/// Messages of a higher priority are dequeued before any message of a lower priority,
+/// while the order of messages of the same priority is preserved.
+enum class Priority : uint8_t
+{
+    /// Regular traffic, subject to a bounded mailbox's overflow policy.
+    Normal,
+    /// Latency-sensitive traffic that bypasses the backlog of normal messages.
+    High,
+    /// Control messages (e.g. stop, flush, reconfigure), delivered ahead of everything else.
+    System,
+};
+
+/// Determines what happens to a message sent to a full bounded mailbox.
+enum class OverflowPolicy
+{
+    /// The sender waits until the consumer has made room.
+    Block,
+    /// The new message is discarded, the send still succeeds.
+    DropNewest,
+    /// The oldest message is discarded by the sender to make room for the new one.
+    DropOldest,
+    /// The send fails, leaving the message with the sender.
+    Fail,
+};
+
+/// Configures an actor's mailbox.
+struct MailboxOptions
+{
+    /// The maximum number of queued messages, or 0 for an unbounded mailbox.
+    /// Messages of higher priorities count towards it, but are always accepted: with OverflowPolicy::DropOldest
+    /// they displace the oldest message of the same or a lower priority, otherwise they may exceed the capacity.
+    size_t capacity = 0;
+
+    /// What to do when sending to a full mailbox. Ignored for unbounded mailboxes.
+    OverflowPolicy overflow = OverflowPolicy::Block;
+
+    /// How a consumer thread waits for a message before parking. Ignored by actors run on an executor,
+    /// which never wait.
+    WaitStrategy wait = WaitStrategy::park();
+};
+
+/// Counters of a bounded mailbox's overflow handling.
+struct MailboxStatistics
+{
+    uint64_t dropped = 0;  ///< Messages discarded due to the overflow policy or a closed mailbox.
+    uint64_t blocked = 0;  ///< Sends that had to wait for free space.
+    uint64_t rejected = 0; ///< Sends that failed due to OverflowPolicy::Fail or try_push().
+};
+
+/// Lock-free multi-producer/single-consumer queue, used as an actor's inbox.
+///
+/// This is a Vyukov-style linked queue: producers enqueue with a single atomic exchange, the consumer dequeues
+/// without any atomic read-modify-write. Dequeued nodes are recycled through a lock-free free list, so that
+/// steady-state messaging does not hit the allocator. Nodes are allocated with @p Allocator, which also takes
+/// back the nodes exceeding MaxCachedNodes. Pass actor::PoolAllocator to draw them from per-thread pools.
+///
+/// The consumer only parks (on a condition variable) when the queue is empty, and producers only signal it
+/// when it is actually parked.
+///
+/// Each Priority has its own queue (lane). The consumer only looks into the lanes above Priority::Normal
+/// if a shared counter indicates that they are non-empty, so normal traffic pays a single extra load.
+///
+/// The mailbox can optionally be bounded, in which case producers reserve a slot in an atomic counter before
+/// enqueuing, and the OverflowPolicy decides what happens if there is none. Unbounded mailboxes skip the counter.
+/// With OverflowPolicy::DropOldest, producers dequeue the messages they displace themselves, so that the mailbox
+/// stays bounded even if the consumer stalls. All dequeues are then serialized by a mutex.
+template <typename T, typename Allocator = std::allocator<T>>
+class Mailbox
+{
+  public:
+    /// The maximum number of dequeued nodes kept for reuse.
+    static constexpr size_t MaxCachedNodes = 1024;
+
+    /// The number of dequeued nodes the consumer collects before handing them back to the producers at once.
+    static constexpr size_t RecycleBatchSize = 32;
+
+    /// The number of message priorities, each of which is served by its own lane.
+    static constexpr size_t PriorityCount = static_cast<size_t>(Priority::System) + 1;
+
+    explicit Mailbox(MailboxOptions options = {});
+    Mailbox(Mailbox&&) = delete;
+    Mailbox(Mailbox const&) = delete;
+    Mailbox& operator=(Mailbox&&) = delete;
+    Mailbox& operator=(Mailbox const&) = delete;
+    ~Mailbox();
+
+    /// Enqueues @p value with the given @p priority, applying the overflow policy if the mailbox is full.
+    /// Safe to be called from any thread.
+    ///
+    /// @returns false if the message was not accepted, which is the case for OverflowPolicy::Fail and for
+    ///          OverflowPolicy::Block if the mailbox got closed while waiting. @p value is left untouched then.
+    bool push(T&& value, Priority priority = Priority::Normal);
+
+    /// Enqueues @p value only if the mailbox has free space, regardless of the overflow policy.
+    /// Safe to be called from any thread.
+    ///
+    /// @returns false if the mailbox is full, leaving @p value untouched.
+    bool try_push(T&& value, Priority priority = Priority::Normal);
+
+    /// Enqueues all elements of @p values at once, waking up the consumer at most once.
+    /// Safe to be called from any thread.
+    ///
+    /// For unbounded mailboxes, the elements are linked up front and published with a single atomic exchange,
+    /// so they appear contiguously in the mailbox. Bounded mailboxes push them one by one,
+    /// stopping at the first element that is not accepted.
+    ///
+    /// @returns the number of accepted elements.
+    template <BatchOf<T> R>
+    size_t push_batch(R&& values, Priority priority = Priority::Normal);
+
+    /// Dequeues the oldest value of the highest non-empty priority without blocking.
+    /// Must only be called by the consumer.
+    [[nodiscard]] std::optional<T> try_pop();
+
+    /// Dequeues a value, blocking until one is available or the mailbox is closed and drained.
+    /// Must only be called by the consumer.
+    ///
+    /// @returns the dequeued value or std::nullopt if the mailbox was closed and is empty.
+    [[nodiscard]] std::optional<T> pop();
+
+    /// Dequeues a value, blocking until one is available, the mailbox is closed and drained,
+    /// or @p deadline is reached. Must only be called by the consumer.
+    ///
+    /// @returns the dequeued value or std::nullopt if the deadline was reached or the mailbox was closed and is
+    ///          empty.
+    template <typename Clock, typename Duration>
+    [[nodiscard]] std::optional<T> pop_until(std::chrono::time_point<Clock, Duration> deadline);
+
+    class PopAwaiter;
+
+    /// Dequeues a value, suspending the calling coroutine instead of blocking while the mailbox is empty.
+    /// Must only be called by the consumer, which must be a coroutine running on an Executor.
+    ///
+    /// @returns an awaitable yielding the dequeued value or std::nullopt if the mailbox was closed and is empty.
+    [[nodiscard]] PopAwaiter async_pop() noexcept
+    {
+        return PopAwaiter { *this };
+    }
+
+    /// Tests whether the mailbox is empty.
+    ///
+    /// Only reliable when called by the consumer, but safe to be called from any thread.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return std::ranges::all_of(_lanes, [](Lane const& lane) {
+            return lane.head.load() == lane.tail.load(std::memory_order_acquire);
+        });
+    }
+
+    /// Closes the mailbox, waking up the consumer. Values already enqueued can still be dequeued.
+    void close();
+
+    /// Fills the cache of reusable nodes with up to @p count nodes, allocated by the calling thread.
+    ///
+    /// Called by a consumer pinned to a NUMA node, this places the nodes that producers keep reusing on that node.
+    /// Safe to be called from any thread.
+    void preallocate(size_t count = MaxCachedNodes);
+
+    [[nodiscard]] bool closed() const noexcept
+    {
+        return _closed.load();
+    }
+
+    /// Returns the maximum number of queued messages, or 0 if the mailbox is unbounded.
+    [[nodiscard]] size_t capacity() const noexcept
+    {
+        return _options.capacity;
+    }
+
+    [[nodiscard]] MailboxStatistics statistics() const noexcept
+    {
+        return MailboxStatistics {
+            .dropped = _dropped.load(std::memory_order_relaxed),
+            .blocked = _blocked.load(std::memory_order_relaxed),
+            .rejected = _rejected.load(std::memory_order_relaxed),
+        };
+    }
+
+    /// Returns a snapshot of the mailbox's metrics, which are all zero unless built with ACTOR_METRICS.
+    [[nodiscard]] QueueMetrics metrics() const
+    {
+        return _metrics.snapshot({});
+    }
+
+  private:
+    struct Node
+    {
+        std::atomic<Node*> next = nullptr;
+        std::atomic<Node*> freeLast = nullptr; // The last node of the free list, if this node is its first.
+        std::optional<T> value;
+        [[no_unique_address]] detail::Timestamp enqueuedAt {};
+    };
+
+    struct Lane
+    {
+        // Producer side: most recently enqueued node.
+        alignas(CacheLineSize) std::atomic<Node*> head;
+
+        // Consumer side: the node preceding the next value to dequeue.
+        alignas(CacheLineSize) std::atomic<Node*> tail;
+    };
+
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    Node* new_node();
+    void delete_node(Node* node) noexcept;
+    Node* acquire_node();
+    void release_nodes(Node* first, Node* last);
+    void recycle_node(Node* node);
+    void link(Node* first, Node* last, Priority priority);
+    void enqueue(T&& value, Priority priority);
+    std::optional<T> dequeue(Lane& lane);
+    std::optional<T> dequeue_any();
+    bool push_displacing(T&& value, Priority priority);
+    bool reserve(bool mayBlock);
+    void release();
+    void wakeup();
+
+    std::array<Lane, PriorityCount> _lanes;
+
+    // The number of messages enqueued above Priority::Normal.
+    alignas(CacheLineSize) std::atomic<size_t> _urgent = 0;
+
+    // Producer side: nodes available for reuse.
+    alignas(CacheLineSize) std::atomic<Node*> _freeList = nullptr;
+    std::atomic<size_t> _freeCount = 0;
+
+    // Consumer side.
+    alignas(CacheLineSize) Node* _recycled = nullptr;
+    Node* _recycledLast = nullptr;
+    size_t _recycledCount = 0;
+    std::atomic<bool> _parked = false;
+    std::atomic<bool> _closed = false;
+    std::mutex _parkLock;
+    std::condition_variable _parkCondition;
+    Runnable* _parkedCoroutine = nullptr; // Guarded by _parkLock.
+    Executor* _parkedExecutor = nullptr;  // Guarded by _parkLock.
+    detail::Spinner _spinner;
+
+    // Bounded mailboxes only: the number of reserved slots, and the producers waiting for one.
+    alignas(CacheLineSize) std::atomic<size_t> _size = 0;
+    std::atomic<size_t> _blockedSenders = 0;
+    std::atomic<uint64_t> _dropped = 0;
+    std::atomic<uint64_t> _blocked = 0;
+    std::atomic<uint64_t> _rejected = 0;
+    std::mutex _dequeueLock; // OverflowPolicy::DropOldest only: serializes the consumer and displacing producers.
+    MailboxOptions _options;
+    [[no_unique_address]] NodeAllocator _allocator;
+    [[no_unique_address]] detail::QueueRecorder<> _metrics;
+    std::mutex _spaceLock;
+    std::condition_variable _spaceCondition;
+};
+
+/// Awaitable returned by Mailbox::async_pop().
+template <typename T, typename Allocator>
+class [[nodiscard]] Mailbox<T, Allocator>::PopAwaiter: private Runnable
+{
+  public:
+    explicit PopAwaiter(Mailbox& mailbox) noexcept:
+        _mailbox { mailbox }
+    {
+    }
+
+    bool await_ready()
+    {
+        return try_complete();
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        _executor = Executor::current();
+        if (!_executor)
+            throw std::logic_error("Mailboxes can only be awaited from coroutines running on an actor::Executor");
+
+        _handle = handle;
+        if (!park())
+            _executor->schedule(*this); // Not empty (or closed) anymore, so retry from the executor.
+        return true;
+    }
+
+    std::optional<T> await_resume()
+    {
+        return std::move(_value);
+    }
+
+  private:
+    /// Tries to dequeue a value.
+    ///
+    /// @returns true if a value was dequeued, or if the mailbox is closed and drained.
+    bool try_complete()
+    {
+        _value = _mailbox.try_pop();
+        if (_value)
+            return true;
+        if (!_mailbox.closed())
+            return false;
+
+        // Values enqueued before closing must still be delivered, even if they were not visible a moment ago.
+        _value = _mailbox.try_pop();
+        return true;
+    }
+
+    /// Registers the coroutine for being resumed by the next push, unless the mailbox is non-empty already.
+    bool park()
+    {
+        auto _ = std::unique_lock { _mailbox._parkLock };
+        _mailbox._parked.store(true);
+        if (!_mailbox.empty() || _mailbox.closed())
+        {
+            _mailbox._parked.store(false);
+            return false;
+        }
+        _mailbox._parkedCoroutine = this;
+        _mailbox._parkedExecutor = _executor;
+        return true;
+    }
+
+    void run() override
+    {
+        if (!try_complete())
+        {
+            // The producer that woke us up has not linked its node yet, so wait for the next push,
+            // or retry later if the node is about to become visible.
+            if (!park())
+                _executor->schedule(*this);
+            return;
+        }
+
+        // Must be last, as resuming may destroy this awaiter.
+        _handle.resume();
+    }
+
+    Mailbox& _mailbox;
+    Executor* _executor = nullptr;
+    std::coroutine_handle<> _handle;
+    std::optional<T> _value;
+};
+
+// ----------------------------------------------------------------------------
+
+template <typename T, typename Allocator>
+Mailbox<T, Allocator>::Mailbox(MailboxOptions options):
+    _spinner { options.wait }, _options { options }
+{
+    for (auto& lane: _lanes)
+    {
+        auto* sentinel = new_node();
+        lane.head.store(sentinel, std::memory_order_relaxed);
+        lane.tail.store(sentinel, std::memory_order_relaxed);
+    }
+}
+
+template <typename T, typename Allocator>
+Mailbox<T, Allocator>::~Mailbox()
+{
+    Node* node = nullptr;
+    for (auto& lane: _lanes)
+    {
+        node = lane.tail.load();
+        while (node)
+            delete_node(std::exchange(node, node->next.load()));
+    }
+
+    node = _freeList.load();
+    while (node)
+        delete_node(std::exchange(node, node->next.load()));
+
+    node = _recycled;
+    while (node)
+        delete_node(std::exchange(node, node->next.load()));
+}
+
+template <typename T, typename Allocator>
+auto Mailbox<T, Allocator>::new_node() -> Node*
+{
+    auto* node = NodeTraits::allocate(_allocator, 1);
+    NodeTraits::construct(_allocator, node);
+    return node;
+}
+
+template <typename T, typename Allocator>
+void Mailbox<T, Allocator>::delete_node(Node* node) noexcept
+{
+    NodeTraits::destroy(_allocator, node);
+    NodeTraits::deallocate(_allocator, node, 1);
+}
+
+template <typename T, typename Allocator>
+auto Mailbox<T, Allocator>::acquire_node() -> Node*
+{
+    // Take the whole free list at once (an exchange is not prone to ABA), keep the first node and hand
+    // the remainder back, whose last node the first one knows.
+    auto* node = _freeList.exchange(nullptr, std::memory_order_acquire);
+    if (!node)
+        return new_node();
+
+    --_freeCount;
+    if (auto* rest = node->next.load(std::memory_order_relaxed))
+        release_nodes(rest, node->freeLast.load(std::memory_order_relaxed));
+
+    node->next.store(nullptr, std::memory_order_relaxed);
+    return node;
+}
+
+template <typename T, typename Allocator>
+void Mailbox<T, Allocator>::release_nodes(Node* first, Node* last)
+{
+    // Only ever publish onto an empty free list, so that the last node is always known without walking the list,
+    // and nodes owned by others are never read. A non-empty list is taken over and appended to the chain instead.
+    while (true)
+    {
+        first->freeLast.store(last, std::memory_order_relaxed);
+        auto* expected = static_cast<Node*>(nullptr);
+        if (_freeList.compare_exchange_strong(expected, first, std::memory_order_release, std::memory_order_relaxed))
+            return;
+
+        if (auto* taken = _freeList.exchange(nullptr, std::memory_order_acquire))
+        {
+            last->next.store(taken, std::memory_order_relaxed);
+            last = taken->freeLast.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T, typename Allocator>
+void Mailbox<T, Allocator>::preallocate(size_t count)
+{
+    count = std::min(count, MaxCachedNodes - std::min(MaxCachedNodes, _freeCount.load(std::memory_order_relaxed)));
+    if (count == 0)
+        return;
+
+    auto* first = new_node();
+    auto* last = first;
+    for (size_t i = 1; i < count; ++i)
+    {
+        auto* node = new_node();
+        node->next.store(first, std::memory_order_relaxed);
+        first = node;
+    }
+
+    _freeCount += count;
+    release_nodes(first, last);
+}
+
+template <typename T, typename Allocator>
+void Mailbox<T, Allocator>::recycle_node(Node* node)
+{
+    node->next.store(_recycled, std::memory_order_relaxed);
+    _recycled = node;
+    if (!_recycledLast)
+        _recycledLast = node;
+    if (++_recycledCount < RecycleBatchSize)
+        return;
+
+    // Publish the collected batch at once, or drop it if enough nodes are cached already.
+    auto* first = std::exchange(_recycled, nullptr);
+    auto* last = std::exchange(_recycledLast, nullptr);
+    _recycledCount = 0;
+
+    if (_freeCount.load(std::memory_order_relaxed) >= MaxCachedNodes)
+    {
+        while (first)
+            delete_node(std::exchange(first, first->next.load(std::memory_order_relaxed)));
+        return;
+    }
+
+    _freeCount += RecycleBatchSize;
+    release_nodes(first, last);
+}
+
+template <typename T, typename Allocator>
+bool Mailbox<T, Allocator>::reserve(bool mayBlock)
+{
+    auto size = _size.load();
+    auto waited = false;
+    while (true)
+    {
+        if (size < _options.capacity)
+        {
+            if (_size.compare_exchange_weak(size, size + 1))
+                return true;
+            continue;
+        }
+
+        if (!mayBlock || _closed.load())
+            return false;
+
+        if (!std::exchange(waited, true))
+            _blocked.fetch_add(1, std::memory_order_relaxed);
+
+        // Registering as blocked before re-checking the size pairs with release(), which frees a slot
+        // before checking for blocked senders.
+        auto lock = std::unique_lock { _spaceLock };
+        ++_blockedSenders;
+        auto const blockedSince = _metrics.now();
+        _spaceCondition.wait(lock, [this]() { return _size.load() < _options.capacity || _closed.load(); });
+        _metrics.send_blocked(blockedSince);
+        --_blockedSenders;
+        size = _size.load();
+    }
+}
+
+template <typename T, typename Allocator>
+void Mailbox<T, Allocator>::release()
+{
+    _size.fetch_sub(1);
+    if (_blockedSenders.load() != 0)
+    {
+        auto _ = std::unique_lock { _spaceLock };
+        _spaceCondition.notify_one();
+    }
+}
+
+template <typename T, typename Allocator>
+void Mailbox<T, Allocator>::link(Node* first, Node* last, Priority priority)
+{
+    auto& lane = _lanes[static_cast<size_t>(priority)];
+    auto* prev = lane.head.exchange(last);
+    prev->next.store(first, std::memory_order_release);
+
+    if (priority != Priority::Normal)
+    {
+        auto count = size_t { 1 };
+        for (auto* node = first; node != last; node = node->next.load(std::memory_order_relaxed))
+            ++count;
+        _urgent.fetch_add(count);
+    }
+
+    if (_parked.load())
+        wakeup();
+}
+
+template <typename T, typename Allocator>
+void Mailbox<T, Allocator>::enqueue(T&& value, Priority priority)
+{
+    auto* node = acquire_node();
+    node->value.emplace(std::move(value));
+    node->enqueuedAt = _metrics.now();
+    _metrics.enqueued(1);
+    link(node, node, priority);
+}
+
+template <typename T, typename Allocator>
+bool Mailbox<T, Allocator>::push(T&& value, Priority priority)
+{
+    if (_options.capacity != 0 && _options.overflow == OverflowPolicy::DropOldest)
+        return push_displacing(std::move(value), priority);
+
+    if (_options.capacity != 0 && priority != Priority::Normal)
+        _size.fetch_add(1); // Always accepted.
+    else if (_options.capacity != 0)
+    {
+        switch (_options.overflow)
+        {
+            case OverflowPolicy::Block:
+                if (!reserve(true))
+                {
+                    _dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                break;
+            case OverflowPolicy::DropNewest:
+                if (!reserve(false))
+                {
+                    _dropped.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+                break;
+            case OverflowPolicy::DropOldest:
+                break;
+            case OverflowPolicy::Fail:
+                if (!reserve(false))
+                {
+                    _rejected.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                break;
+        }
+    }
+
+    enqueue(std::move(value), priority);
+    return true;
+}
+
+template <typename T, typename Allocator>
+bool Mailbox<T, Allocator>::push_displacing(T&& value, Priority priority)
+{
+    // Reserving and enqueuing under the lock, there are no reserved slots whose message is not visible yet,
+    // so a full mailbox always has a message to displace, unless all of them are of a higher priority.
+    auto _ = std::unique_lock { _dequeueLock };
+    if (_size.load() < _options.capacity)
+        _size.fetch_add(1);
+    else
+    {
+        auto displaced = std::optional<T> {};
+        for (auto lane = size_t { 0 }; !displaced && lane <= static_cast<size_t>(priority); ++lane)
+            if ((displaced = dequeue(_lanes[lane])) && lane != static_cast<size_t>(Priority::Normal))
+                _urgent.fetch_sub(1, std::memory_order_relaxed);
+
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        if (!displaced)
+            return true; // The new message is the least important one.
+    }
+
+    enqueue(std::move(value), priority);
+    return true;
+}
+
+template <typename T, typename Allocator>
+bool Mailbox<T, Allocator>::try_push(T&& value, Priority priority)
+{
+    auto lock = _options.overflow == OverflowPolicy::DropOldest ? std::unique_lock { _dequeueLock }
+                                                                  : std::unique_lock<std::mutex> {};
+    if (_options.capacity != 0 && priority != Priority::Normal)
+        _size.fetch_add(1); // Always accepted.
+    else if (_options.capacity != 0 && !reserve(false))
+    {
+        _rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    enqueue(std::move(value), priority);
+    return true;
+}
+
+template <typename T, typename Allocator>
+template <BatchOf<T> R>
+size_t Mailbox<T, Allocator>::push_batch(R&& values, Priority priority)
+{
+    if (_options.capacity != 0)
+    {
+        auto count = size_t { 0 };
+        for (auto current = std::ranges::begin(values); current != std::ranges::end(values); ++current)
+        {
+            auto value = [&]() -> T {
+                if constexpr (std::is_lvalue_reference_v<R>)
+                    return T(*current);
+                else
+                    return T(std::ranges::iter_move(current));
+            }();
+            if (!push(std::move(value), priority))
+                break;
+            ++count;
+        }
+        return count;
+    }
+
+    auto count = size_t { 0 };
+    Node* first = nullptr;
+    Node* last = nullptr;
+    for (auto current = std::ranges::begin(values); current != std::ranges::end(values); ++current)
+    {
+        auto* node = acquire_node();
+        if constexpr (std::is_lvalue_reference_v<R>)
+            node->value.emplace(*current);
+        else
+            node->value.emplace(std::ranges::iter_move(current));
+        node->enqueuedAt = _metrics.now();
+        if (last)
+            last->next.store(node, std::memory_order_relaxed);
+        else
+            first = node;
+        last = node;
+        ++count;
+    }
+
+    if (!first)
+        return 0;
+
+    _metrics.enqueued(count);
+    link(first, last, priority);
+    return count;
+}
+
+template <typename T, typename Allocator>
+std::optional<T> Mailbox<T, Allocator>::try_pop()
+{
+    if (_options.capacity == 0)
+        return dequeue_any();
+
+    auto lock = _options.overflow == OverflowPolicy::DropOldest ? std::unique_lock { _dequeueLock }
+                                                                  : std::unique_lock<std::mutex> {};
+    auto value = dequeue_any();
+    if (value)
+        release();
+    return value;
+}
+
+template <typename T, typename Allocator>
+std::optional<T> Mailbox<T, Allocator>::dequeue_any()
+{
+    if (_urgent.load(std::memory_order_acquire) != 0)
+    {
+        for (auto priority = PriorityCount - 1; priority > 0; --priority)
+        {
+            if (auto value = dequeue(_lanes[priority]))
+            {
+                _urgent.fetch_sub(1, std::memory_order_relaxed);
+                return value;
+            }
+        }
+    }
+
+    return dequeue(_lanes[static_cast<size_t>(Priority::Normal)]);
+}
+
+template <typename T, typename Allocator>
+std::optional<T> Mailbox<T, Allocator>::dequeue(Lane& lane)
+{
+    auto* tail = lane.tail.load(std::memory_order_relaxed);
+    auto* next = tail->next.load(std::memory_order_acquire);
+    if (!next)
+        return std::nullopt;
+
+    // The dequeued node becomes the new sentinel.
+    auto value = std::optional<T> { std::move(*next->value) };
+    next->value.reset();
+    _metrics.dequeued(next->enqueuedAt);
+    lane.tail.store(next, std::memory_order_release);
+    recycle_node(tail);
+    return value;
+}
+
+template <typename T, typename Allocator>
+std::optional<T> Mailbox<T, Allocator>::pop()
+{
+    return pop_until(std::chrono::steady_clock::time_point::max());
+}
+
+template <typename T, typename Allocator>
+template <typename Clock, typename Duration>
+std::optional<T> Mailbox<T, Allocator>::pop_until(std::chrono::time_point<Clock, Duration> deadline)
+{
+    while (true)
+    {
+        if (auto value = try_pop())
+            return value;
+
+        if (_closed.load())
+            return try_pop();
+
+        auto const ready = [this]() { return !empty() || _closed.load(); };
+        auto const waitStart = _spinner.start();
+        if (_spinner.spin(waitStart, deadline, ready))
+            continue;
+
+        auto lock = std::unique_lock { _parkLock };
+        _parked.store(true);
+        auto const blockedSince = _metrics.now();
+        auto woken = true;
+        if (deadline == std::chrono::time_point<Clock, Duration>::max())
+            _parkCondition.wait(lock, ready);
+        else
+            woken = _parkCondition.wait_until(lock, deadline, ready);
+        _metrics.receive_blocked(blockedSince);
+        _parked.store(false);
+        _spinner.parked(waitStart);
+        if (!woken)
+            return std::nullopt;
+    }
+}
+
+template <typename T, typename Allocator>
+void Mailbox<T, Allocator>::close()
+{
+    _closed.store(true);
+    wakeup();
+
+    if (_options.capacity != 0)
+    {
+        auto _ = std::unique_lock { _spaceLock };
+        _spaceCondition.notify_all();
+    }
+}
+
+template <typename T, typename Allocator>
+void Mailbox<T, Allocator>::wakeup()
+{
+    auto _ = std::unique_lock { _parkLock };
+    if (auto* coroutine = std::exchange(_parkedCoroutine, nullptr))
+    {
+        _parked.store(false);
+        _parkedExecutor->schedule(*coroutine);
+    }
+    else
+        _parkCondition.notify_one();
+}
+
+} // namespace actor
@@ -0,0 +1,400 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// Define to 1 (or configure with -DACTOR_METRICS=ON) to instrument channels, controllers and actors.
+// When disabled, which is the default, the instrumentation compiles down to nothing.
+#if !defined(ACTOR_METRICS)
+    #define ACTOR_METRICS 0
+#endif
+
+namespace actor
+{
+
+/// Whether channels, controllers and actors are instrumented (see ACTOR_METRICS).
+inline constexpr bool MetricsEnabled = ACTOR_METRICS != 0;
+
+/// The clock all metrics are measured with.
+using MetricsClock = std::chrono::steady_clock;
+
+/// Percentiles of a LatencyHistogram.
+struct LatencySummary
+{
+    uint64_t count = 0;
+    std::chrono::nanoseconds mean {};
+    std::chrono::nanoseconds p50 {};
+    std::chrono::nanoseconds p90 {};
+    std::chrono::nanoseconds p99 {};
+    std::chrono::nanoseconds p999 {};
+    std::chrono::nanoseconds max {};
+};
+
+/// Snapshot of the metrics of a queue: a channel or an actor's inbox.
+struct QueueMetrics
+{
+    std::string name;                           ///< The channel's name, empty for actors.
+    uint64_t enqueued = 0;                      ///< Values sent.
+    uint64_t dequeued = 0;                      ///< Values received (or discarded by an inbox's overflow policy).
+    uint64_t depth = 0;                         ///< Values currently queued.
+    uint64_t highWaterMark = 0;                 ///< The maximum depth seen so far.
+    std::chrono::nanoseconds sendBlocked {};    ///< Total time senders spent blocked.
+    std::chrono::nanoseconds receiveBlocked {}; ///< Total time receivers spent blocked.
+    LatencySummary latency;                     ///< Time from enqueueing a value until it was dequeued.
+};
+
+/// Snapshot of the metrics of a channel::Controller, shared by all of its channels.
+struct ControllerMetrics
+{
+    uint64_t lockAcquisitions = 0; ///< Acquisitions of the controller's mutex.
+    uint64_t lockContentions = 0;  ///< Acquisitions that found the mutex held by another thread.
+    uint64_t wakeups = 0;          ///< Blocked threads woken up by a channel.
+    uint64_t spuriousWakeups = 0;  ///< Wakeups after which the thread found nothing to do and blocked again.
+};
+
+/// Lock-free histogram of latencies with a bounded relative error, in the spirit of HdrHistogram.
+///
+/// Each power of two is split into SubBucketCount linear sub-buckets, so that recorded values are reported with
+/// a relative error of at most 1/SubBucketCount, across the full range of nanoseconds in 64 bits. Recording is
+/// a single relaxed atomic increment (plus the sum and maximum), so it is safe from any number of threads, and
+/// a summary may be taken concurrently.
+class LatencyHistogram
+{
+  public:
+    static constexpr size_t SubBucketBits = 4;
+    static constexpr size_t SubBucketCount = size_t { 1 } << SubBucketBits;
+    static constexpr size_t BucketCount = SubBucketCount + (64 - SubBucketBits) * SubBucketCount;
+
+    void record(std::chrono::nanoseconds latency) noexcept
+    {
+        auto const value = static_cast<uint64_t>(std::max<int64_t>(0, latency.count()));
+        _buckets[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+        _sum.fetch_add(value, std::memory_order_relaxed);
+        auto max = _max.load(std::memory_order_relaxed);
+        while (value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+            ;
+    }
+
+    /// Returns the percentiles of all latencies recorded so far.
+    [[nodiscard]] LatencySummary summary() const noexcept;
+
+  private:
+    /// Values below SubBucketCount get a bucket each, larger ones go into the sub-bucket of their power of two.
+    static constexpr size_t bucket_of(uint64_t value) noexcept
+    {
+        if (value < SubBucketCount)
+            return static_cast<size_t>(value);
+        auto const octave = static_cast<size_t>(std::bit_width(value)) - 1 - SubBucketBits;
+        return SubBucketCount + octave * SubBucketCount + static_cast<size_t>((value >> octave) - SubBucketCount);
+    }
+
+    /// Returns the largest value that falls into @p bucket.
+    static constexpr uint64_t highest_value_of(size_t bucket) noexcept
+    {
+        if (bucket < SubBucketCount)
+            return bucket;
+        auto const octave = (bucket - SubBucketCount) / SubBucketCount;
+        auto const subBucket = (bucket - SubBucketCount) % SubBucketCount;
+        return ((SubBucketCount + subBucket + 1) << octave) - 1;
+    }
+
+    std::array<std::atomic<uint64_t>, BucketCount> _buckets {};
+    std::atomic<uint64_t> _sum = 0;
+    std::atomic<uint64_t> _max = 0;
+};
+
+/// Formats @p metrics as a single line of text.
+std::string to_string(QueueMetrics const& metrics);
+std::string to_string(ControllerMetrics const& metrics);
+
+/// Formats @p metrics as a JSON object, with durations in nanoseconds.
+std::string to_json(QueueMetrics const& metrics);
+std::string to_json(ControllerMetrics const& metrics);
+
+namespace detail
+{
+    /// Stands in for state that only exists if metrics are enabled.
+    struct NoMetrics
+    {
+    };
+
+    /// A point in time, which is only taken if metrics are enabled.
+    using Timestamp = std::conditional_t<MetricsEnabled, MetricsClock::time_point, NoMetrics>;
+
+    /// The live counters behind QueueMetrics. Updated lock-free, so that producers and consumers of lock-free
+    /// queues can update them as well.
+    template <bool Enabled = MetricsEnabled>
+    class QueueRecorder
+    {
+      public:
+        [[nodiscard]] static MetricsClock::time_point now() noexcept
+        {
+            return MetricsClock::now();
+        }
+
+        /// Accounts for @p count values about to be enqueued, which must happen before they can be dequeued.
+        void enqueued(size_t count) noexcept
+        {
+            auto const enqueued = _enqueued.fetch_add(count, std::memory_order_relaxed) + count;
+            auto const dequeued = _dequeued.load(std::memory_order_relaxed);
+            auto const depth = enqueued > dequeued ? enqueued - dequeued : 0;
+            auto highWaterMark = _highWaterMark.load(std::memory_order_relaxed);
+            while (depth > highWaterMark
+                   && !_highWaterMark.compare_exchange_weak(highWaterMark, depth, std::memory_order_relaxed))
+                ;
+        }
+
+        /// Accounts for a value dequeued after having been enqueued at @p enqueuedAt.
+        void dequeued(MetricsClock::time_point enqueuedAt) noexcept
+        {
+            _dequeued.fetch_add(1, std::memory_order_relaxed);
+            _latency.record(MetricsClock::now() - enqueuedAt);
+        }
+
+        void send_blocked(MetricsClock::time_point since) noexcept
+        {
+            _sendBlocked.fetch_add(static_cast<uint64_t>((MetricsClock::now() - since).count()),
+                                   std::memory_order_relaxed);
+        }
+
+        void receive_blocked(MetricsClock::time_point since) noexcept
+        {
+            _receiveBlocked.fetch_add(static_cast<uint64_t>((MetricsClock::now() - since).count()),
+                                      std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] QueueMetrics snapshot(std::string name) const
+        {
+            auto const dequeued = _dequeued.load(std::memory_order_relaxed);
+            auto const enqueued = std::max(dequeued, _enqueued.load(std::memory_order_relaxed));
+            return QueueMetrics {
+                .name = std::move(name),
+                .enqueued = enqueued,
+                .dequeued = dequeued,
+                .depth = enqueued - dequeued,
+                .highWaterMark = _highWaterMark.load(std::memory_order_relaxed),
+                .sendBlocked = std::chrono::nanoseconds(_sendBlocked.load(std::memory_order_relaxed)),
+                .receiveBlocked = std::chrono::nanoseconds(_receiveBlocked.load(std::memory_order_relaxed)),
+                .latency = _latency.summary(),
+            };
+        }
+
+      private:
+        std::atomic<uint64_t> _enqueued = 0;
+        std::atomic<uint64_t> _dequeued = 0;
+        std::atomic<uint64_t> _highWaterMark = 0;
+        std::atomic<uint64_t> _sendBlocked = 0;
+        std::atomic<uint64_t> _receiveBlocked = 0;
+        LatencyHistogram _latency;
+    };
+
+    template <>
+    class QueueRecorder<false>
+    {
+      public:
+        [[nodiscard]] static Timestamp now() noexcept
+        {
+            return {};
+        }
+
+        void enqueued(size_t /*count*/) noexcept {}
+        void dequeued(Timestamp /*enqueuedAt*/) noexcept {}
+        void send_blocked(Timestamp /*since*/) noexcept {}
+        void receive_blocked(Timestamp /*since*/) noexcept {}
+
+        [[nodiscard]] QueueMetrics snapshot(std::string name) const
+        {
+            auto metrics = QueueMetrics {};
+            metrics.name = std::move(name);
+            return metrics;
+        }
+    };
+
+    /// The live counters behind ControllerMetrics.
+    template <bool Enabled = MetricsEnabled>
+    class ControllerRecorder
+    {
+      public:
+        /// Locks @p mutex, counting whether it had to wait for another thread.
+        void lock(std::mutex& mutex)
+        {
+            if (!mutex.try_lock())
+            {
+                _lockContentions.fetch_add(1, std::memory_order_relaxed);
+                mutex.lock();
+            }
+            _lockAcquisitions.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// Accounts for a blocked thread having been woken up @p count times, @p spurious of which in vain.
+        void woken_up(size_t count, size_t spurious) noexcept
+        {
+            if (count == 0)
+                return;
+            _wakeups.fetch_add(count, std::memory_order_relaxed);
+            _spuriousWakeups.fetch_add(spurious, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] ControllerMetrics snapshot() const noexcept
+        {
+            return ControllerMetrics {
+                .lockAcquisitions = _lockAcquisitions.load(std::memory_order_relaxed),
+                .lockContentions = _lockContentions.load(std::memory_order_relaxed),
+                .wakeups = _wakeups.load(std::memory_order_relaxed),
+                .spuriousWakeups = _spuriousWakeups.load(std::memory_order_relaxed),
+            };
+        }
+
+      private:
+        std::atomic<uint64_t> _lockAcquisitions = 0;
+        std::atomic<uint64_t> _lockContentions = 0;
+        std::atomic<uint64_t> _wakeups = 0;
+        std::atomic<uint64_t> _spuriousWakeups = 0;
+    };
+
+    template <>
+    class ControllerRecorder<false>
+    {
+      public:
+        static void lock(std::mutex& mutex)
+        {
+            mutex.lock();
+        }
+
+        void woken_up(size_t /*count*/, size_t /*spurious*/) noexcept {}
+
+        [[nodiscard]] ControllerMetrics snapshot() const noexcept
+        {
+            return {};
+        }
+    };
+
+    /// Writes the members shared by the text and JSON formats of a LatencySummary.
+    template <typename Field>
+    void write_latency(LatencySummary const& latency, Field&& field)
+    {
+        field("count", latency.count);
+        field("mean", latency.mean.count());
+        field("p50", latency.p50.count());
+        field("p90", latency.p90.count());
+        field("p99", latency.p99.count());
+        field("p999", latency.p999.count());
+        field("max", latency.max.count());
+    }
+
+    /// Writes a JSON string literal.
+    inline void write_json_string(std::ostream& out, std::string const& text)
+    {
+        out << '"';
+        for (auto const c: text)
+        {
+            if (c == '"' || c == '\\')
+                out << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20)
+                out << "\\u00" << "0123456789abcdef"[(c >> 4) & 0xF] << "0123456789abcdef"[c & 0xF];
+            else
+                out << c;
+        }
+        out << '"';
+    }
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+
+inline LatencySummary LatencyHistogram::summary() const noexcept
+{
+    auto counts = std::array<uint64_t, BucketCount> {};
+    auto result = LatencySummary {};
+    for (size_t i = 0; i < BucketCount; ++i)
+    {
+        counts[i] = _buckets[i].load(std::memory_order_relaxed);
+        result.count += counts[i];
+    }
+
+    if (result.count == 0)
+        return result;
+
+    auto const max = _max.load(std::memory_order_relaxed);
+    auto const percentile = [&](double fraction) {
+        auto const rank = std::max<uint64_t>(1, static_cast<uint64_t>(fraction * static_cast<double>(result.count)));
+        auto seen = uint64_t { 0 };
+        for (size_t i = 0; i < BucketCount; ++i)
+        {
+            seen += counts[i];
+            if (seen >= rank)
+                return std::chrono::nanoseconds(std::min(highest_value_of(i), max));
+        }
+        return std::chrono::nanoseconds(max);
+    };
+
+    result.mean = std::chrono::nanoseconds(_sum.load(std::memory_order_relaxed) / result.count);
+    result.p50 = percentile(0.5);
+    result.p90 = percentile(0.9);
+    result.p99 = percentile(0.99);
+    result.p999 = percentile(0.999);
+    result.max = std::chrono::nanoseconds(max);
+    return result;
+}
+
+inline std::string to_string(QueueMetrics const& metrics)
+{
+    auto out = std::ostringstream {};
+    out << (metrics.name.empty() ? "<unnamed>" : metrics.name) << ": enqueued=" << metrics.enqueued
+        << " dequeued=" << metrics.dequeued << " depth=" << metrics.depth << " high_water_mark=" << metrics.highWaterMark
+        << " send_blocked_ns=" << metrics.sendBlocked.count()
+        << " receive_blocked_ns=" << metrics.receiveBlocked.count() << " latency_ns{";
+    auto separator = "";
+    detail::write_latency(metrics.latency, [&](char const* key, auto value) {
+        out << std::exchange(separator, " ") << key << '=' << value;
+    });
+    out << '}';
+    return out.str();
+}
+
+inline std::string to_string(ControllerMetrics const& metrics)
+{
+    auto out = std::ostringstream {};
+    out << "lock_acquisitions=" << metrics.lockAcquisitions << " lock_contentions=" << metrics.lockContentions
+        << " wakeups=" << metrics.wakeups << " spurious_wakeups=" << metrics.spuriousWakeups;
+    return out.str();
+}
+
+inline std::string to_json(QueueMetrics const& metrics)
+{
+    auto out = std::ostringstream {};
+    out << "{\"name\":";
+    detail::write_json_string(out, metrics.name);
+    out << ",\"enqueued\":" << metrics.enqueued << ",\"dequeued\":" << metrics.dequeued
+        << ",\"depth\":" << metrics.depth << ",\"high_water_mark\":" << metrics.highWaterMark
+        << ",\"send_blocked_ns\":" << metrics.sendBlocked.count()
+        << ",\"receive_blocked_ns\":" << metrics.receiveBlocked.count() << ",\"latency_ns\":{";
+    auto separator = "";
+    detail::write_latency(metrics.latency, [&](char const* key, auto value) {
+        out << std::exchange(separator, ",") << '"' << key << "\":" << value;
+    });
+    out << "}}";
+    return out.str();
+}
+
+inline std::string to_json(ControllerMetrics const& metrics)
+{
+    auto out = std::ostringstream {};
+    out << "{\"lock_acquisitions\":" << metrics.lockAcquisitions
+        << ",\"lock_contentions\":" << metrics.lockContentions << ",\"wakeups\":" << metrics.wakeups
+        << ",\"spurious_wakeups\":" << metrics.spuriousWakeups << '}';
+    return out.str();
+}
+
+} // namespace actor
@@ -0,0 +1,253 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <actor/cache_line.hpp>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace actor
+{
+
+namespace detail
+{
+    /// Per-thread cache of small memory blocks, carved from slabs of SlabSize bytes.
+    ///
+    /// Block sizes are rounded up to a power of two (a size class). Each slab serves a single size class, and is
+    /// aligned to its size, so that the pool owning a block is found by masking the block's address. Blocks freed
+    /// by the owning thread go onto a plain free list. Blocks freed by any other thread are pushed onto an atomic
+    /// free list of the owning pool, which the owner takes over as a whole once its own list runs dry.
+    ///
+    /// Pools are never destroyed: when its thread exits, a pool is handed to the next thread that starts
+    /// allocating, with all its slabs and free blocks. Threads that allocate while exiting (from destructors of
+    /// thread-local objects) share a mutex-protected fallback pool.
+    class SlabPool
+    {
+      public:
+        static constexpr size_t SlabSize = size_t { 64 } * 1024;
+        static constexpr size_t MinBlockSize = 16;
+        static constexpr size_t MaxBlockSize = 8192;
+        static constexpr size_t ClassCount = std::bit_width(MaxBlockSize / MinBlockSize);
+
+        /// The alignment of every block.
+        static constexpr size_t BlockAlignment = alignof(std::max_align_t);
+
+        /// Allocates a block of at least @p size bytes, which must not exceed MaxBlockSize.
+        [[nodiscard]] static void* allocate(size_t size);
+
+        /// Frees @p block, which was allocated with the same @p size, from any thread.
+        static void deallocate(void* block, size_t size) noexcept;
+
+      private:
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        /// The header at the start of each slab.
+        struct Slab
+        {
+            SlabPool* owner;
+        };
+
+        /// Blocks start past the header, on a cache line boundary.
+        static constexpr size_t HeaderSize = CacheLineSize;
+
+        struct SizeClass
+        {
+            FreeBlock* local = nullptr;                                 // Owning thread only.
+            alignas(CacheLineSize) std::atomic<FreeBlock*> remote = nullptr; // Freed by other threads.
+        };
+
+        static constexpr size_t class_of(size_t size) noexcept
+        {
+            return size <= MinBlockSize ? 0 : std::bit_width(size - 1) - std::bit_width(MinBlockSize - 1);
+        }
+
+        static constexpr size_t block_size(size_t sizeClass) noexcept
+        {
+            return MinBlockSize << sizeClass;
+        }
+
+        /// Takes a block of the given size class. Must only be called by the pool's owner.
+        [[nodiscard]] void* take(size_t sizeClass);
+
+        /// Carves a new slab into free blocks of the given size class.
+        void refill(size_t sizeClass);
+
+        /// Returns the calling thread's pool, acquiring one first if needed, or nullptr if the thread is exiting.
+        [[nodiscard]] static SlabPool* acquire_local();
+
+        /// Hands the exiting thread's pool on to the next thread.
+        struct Releaser
+        {
+            ~Releaser();
+        };
+
+        std::array<SizeClass, ClassCount> _classes {};
+        SlabPool* _nextAbandoned = nullptr;
+
+        static inline thread_local SlabPool* _local = nullptr;
+        static inline thread_local bool _exited = false;
+        static inline thread_local Releaser _releaser {};
+
+        static inline std::mutex _abandonedLock;
+        static inline SlabPool* _abandoned = nullptr; // Pools of exited threads, guarded by _abandonedLock.
+
+        static inline std::mutex _fallbackLock;
+        static inline SlabPool* _fallback = nullptr; // Guarded by _fallbackLock.
+    };
+} // namespace detail
+
+/// Allocator drawing small allocations from per-thread slab pools (see detail::SlabPool).
+///
+/// Allocation takes a block from the calling thread's pool without any synchronization. Freeing from the same
+/// thread does likewise, and freeing from another thread costs one atomic push. Allocations larger than
+/// detail::SlabPool::MaxBlockSize, or of over-aligned types, are forwarded to std::allocator.
+///
+/// Mailboxes and channels take it as their Allocator argument. Since pools keep their memory for reuse,
+/// steady-state messaging does not hit the global allocator, regardless of which threads send and receive.
+/// The flip side is that slabs are never returned to the system: a burst leaves the pools at their peak size
+/// for the lifetime of the process, which is why this allocator is opt-in.
+template <typename T>
+class PoolAllocator
+{
+  public:
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+
+    template <typename U>
+    PoolAllocator(PoolAllocator<U> const& /*other*/) noexcept
+    {
+    }
+
+    [[nodiscard]] T* allocate(size_t count)
+    {
+        if (!pooled(count))
+            return std::allocator<T> {}.allocate(count);
+        return static_cast<T*>(detail::SlabPool::allocate(count * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept
+    {
+        if (!pooled(count))
+            std::allocator<T> {}.deallocate(pointer, count);
+        else
+            detail::SlabPool::deallocate(pointer, count * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(PoolAllocator<U> const& /*other*/) const noexcept
+    {
+        return true;
+    }
+
+  private:
+    static constexpr bool pooled(size_t count) noexcept
+    {
+        return alignof(T) <= detail::SlabPool::BlockAlignment && count <= detail::SlabPool::MaxBlockSize / sizeof(T);
+    }
+};
+
+// ----------------------------------------------------------------------------
+
+inline void* detail::SlabPool::allocate(size_t size)
+{
+    auto const sizeClass = class_of(size);
+    if (auto* pool = acquire_local())
+        return pool->take(sizeClass);
+
+    auto _ = std::unique_lock { _fallbackLock };
+    if (!_fallback)
+        _fallback = new SlabPool {};
+    return _fallback->take(sizeClass);
+}
+
+inline void detail::SlabPool::deallocate(void* block, size_t size) noexcept
+{
+    auto const sizeClass = class_of(size);
+    auto* freed = static_cast<FreeBlock*>(block);
+    auto* slab = reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(block) & ~(SlabSize - 1));
+    auto& freeLists = slab->owner->_classes[sizeClass];
+
+    if (slab->owner == _local)
+    {
+        freed->next = freeLists.local;
+        freeLists.local = freed;
+        return;
+    }
+
+    auto* top = freeLists.remote.load(std::memory_order_relaxed);
+    do
+        freed->next = top;
+    while (!freeLists.remote.compare_exchange_weak(top, freed, std::memory_order_release, std::memory_order_relaxed));
+}
+
+inline void* detail::SlabPool::take(size_t sizeClass)
+{
+    auto& freeLists = _classes[sizeClass];
+    if (!freeLists.local)
+    {
+        // Taking the whole list at once is not prone to ABA, unlike popping single blocks.
+        freeLists.local = freeLists.remote.exchange(nullptr, std::memory_order_acquire);
+        if (!freeLists.local)
+            refill(sizeClass);
+    }
+
+    auto* block = freeLists.local;
+    freeLists.local = block->next;
+    return block;
+}
+
+inline void detail::SlabPool::refill(size_t sizeClass)
+{
+    auto* memory = static_cast<std::byte*>(::operator new(SlabSize, std::align_val_t { SlabSize }));
+    std::construct_at(reinterpret_cast<Slab*>(memory), Slab { this });
+
+    // Link the blocks in address order, so that consecutive allocations are adjacent.
+    auto const blockSize = block_size(sizeClass);
+    FreeBlock* first = nullptr;
+    for (auto offset = SlabSize - blockSize; offset >= HeaderSize; offset -= blockSize)
+        first = std::construct_at(reinterpret_cast<FreeBlock*>(memory + offset), FreeBlock { first });
+    _classes[sizeClass].local = first;
+}
+
+inline detail::SlabPool* detail::SlabPool::acquire_local()
+{
+    if (_local || _exited)
+        return _local;
+
+    {
+        auto _ = std::unique_lock { _abandonedLock };
+        if (_abandoned)
+            _local = std::exchange(_abandoned, _abandoned->_nextAbandoned);
+    }
+    if (!_local)
+        _local = new SlabPool {};
+
+    // Using the releaser registers its destructor, which runs when this thread exits.
+    [[maybe_unused]] auto const* releaser = &_releaser;
+    return _local;
+}
+
+inline detail::SlabPool::Releaser::~Releaser()
+{
+    auto* pool = std::exchange(_local, nullptr);
+    _exited = true;
+    if (!pool)
+        return;
+
+    auto _ = std::unique_lock { _abandonedLock };
+    pool->_nextAbandoned = _abandoned;
+    _abandoned = pool;
+}
+
+} // namespace actor
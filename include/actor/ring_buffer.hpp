@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace channel::detail
+{
+
+/// Returns the size of a ring of @p T holding at least @p capacity elements, which is a power of two.
+///
+/// @throw std::length_error if the ring would not fit into the address space.
+template <typename T>
+size_t ring_capacity(size_t capacity)
+{
+    constexpr auto MaxCapacity = std::bit_floor(std::numeric_limits<size_t>::max() / sizeof(T));
+    if (capacity > MaxCapacity)
+        throw std::length_error("Ring buffer capacity too large: " + std::to_string(capacity));
+    return std::bit_ceil(std::max<size_t>(1, capacity));
+}
+
+/// Fixed-capacity FIFO queue over a contiguous, preallocated buffer.
+///
+/// The buffer size is rounded up to a power of two, so that indices can be wrapped with a mask.
+/// The buffer is allocated with @p Allocator upon construction, after which no further allocations take place.
+/// Large capacities are therefore better served by a SegmentedQueue, which only allocates as it fills up.
+template <typename T, typename Allocator = std::allocator<T>>
+class RingBuffer
+{
+  public:
+    /// @throw std::length_error if @p capacity is too large, see ring_capacity().
+    explicit RingBuffer(size_t capacity):
+        _capacity { ring_capacity<T>(capacity) },
+        _mask { _capacity - 1 },
+        _storage { std::allocator_traits<Allocator>::allocate(_allocator, _capacity) }
+    {
+    }
+
+    RingBuffer(RingBuffer&& other) noexcept:
+        _capacity { other._capacity },
+        _mask { other._mask },
+        _allocator { other._allocator },
+        _storage { std::exchange(other._storage, nullptr) },
+        _head { std::exchange(other._head, 0) },
+        _tail { std::exchange(other._tail, 0) }
+    {
+    }
+
+    RingBuffer(RingBuffer const&) = delete;
+    RingBuffer& operator=(RingBuffer&&) = delete;
+    RingBuffer& operator=(RingBuffer const&) = delete;
+
+    ~RingBuffer()
+    {
+        if (!_storage)
+            return;
+
+        while (!empty())
+            pop_front();
+
+        std::allocator_traits<Allocator>::deallocate(_allocator, _storage, _capacity);
+    }
+
+    /// Returns the number of elements that fit into the buffer, which is a power of two.
+    [[nodiscard]] size_t capacity() const noexcept
+    {
+        return _capacity;
+    }
+
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return _tail - _head;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _tail == _head;
+    }
+
+    [[nodiscard]] bool full() const noexcept
+    {
+        return size() == _capacity;
+    }
+
+    /// Appends a new element. The buffer must not be full.
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        auto* slot = std::construct_at(_storage + (_tail & _mask), std::forward<Args>(args)...);
+        ++_tail;
+        return *slot;
+    }
+
+    /// Returns the oldest element. The buffer must not be empty.
+    [[nodiscard]] T& front() noexcept
+    {
+        return _storage[_head & _mask];
+    }
+
+    /// Removes the oldest element. The buffer must not be empty.
+    void pop_front() noexcept
+    {
+        std::destroy_at(_storage + (_head & _mask));
+        ++_head;
+    }
+
+  private:
+    size_t _capacity;
+    size_t _mask;
+    [[no_unique_address]] Allocator _allocator {};
+    T* _storage;
+    size_t _head = 0; // Index of the oldest element.
+    size_t _tail = 0; // Index one past the newest element.
+};
+
+} // namespace channel::detail
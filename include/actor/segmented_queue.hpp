@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace channel::detail
+{
+
+/// Unbounded FIFO queue over a singly linked list of fixed-size segments.
+///
+/// Unlike a growing contiguous buffer, elements are never relocated once enqueued, and growing costs a single
+/// segment allocation rather than a copy of the whole queue. One drained segment is kept for reuse, so a queue
+/// whose size oscillates around a segment boundary does not keep hitting the allocator. Segments are allocated
+/// with @p Allocator.
+template <typename T, typename Allocator = std::allocator<T>>
+class SegmentedQueue
+{
+  public:
+    /// The number of elements per segment.
+    static constexpr size_t SegmentSize = 64;
+
+    SegmentedQueue() = default;
+
+    SegmentedQueue(SegmentedQueue&& other) noexcept:
+        _allocator { other._allocator },
+        _head { std::exchange(other._head, nullptr) },
+        _tail { std::exchange(other._tail, nullptr) },
+        _spare { std::exchange(other._spare, nullptr) },
+        _headIndex { std::exchange(other._headIndex, 0) },
+        _tailIndex { std::exchange(other._tailIndex, SegmentSize) },
+        _size { std::exchange(other._size, 0) }
+    {
+    }
+
+    SegmentedQueue(SegmentedQueue const&) = delete;
+    SegmentedQueue& operator=(SegmentedQueue&&) = delete;
+    SegmentedQueue& operator=(SegmentedQueue const&) = delete;
+
+    ~SegmentedQueue()
+    {
+        while (!empty())
+            pop_front();
+
+        delete_segment(_head);
+        delete_segment(_spare);
+    }
+
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return _size;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    /// Appends a new element, allocating a new segment if the last one is full.
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (_tailIndex == SegmentSize)
+        {
+            auto* segment = _spare ? std::exchange(_spare, nullptr) : new_segment();
+            segment->next = nullptr;
+            if (_tail)
+                _tail->next = segment;
+            else
+                _head = segment;
+            _tail = segment;
+            _tailIndex = 0;
+        }
+
+        auto* slot = std::construct_at(_tail->slot(_tailIndex), std::forward<Args>(args)...);
+        ++_tailIndex;
+        ++_size;
+        return *slot;
+    }
+
+    /// Returns the oldest element. The queue must not be empty.
+    [[nodiscard]] T& front() noexcept
+    {
+        return *std::launder(_head->slot(_headIndex));
+    }
+
+    /// Removes the oldest element. The queue must not be empty.
+    void pop_front() noexcept
+    {
+        std::destroy_at(std::launder(_head->slot(_headIndex)));
+        ++_headIndex;
+        --_size;
+
+        if (_size == 0)
+        {
+            // Start over at the beginning of the (only) segment left.
+            _headIndex = 0;
+            _tailIndex = 0;
+        }
+        else if (_headIndex == SegmentSize)
+        {
+            auto* drained = std::exchange(_head, _head->next);
+            _headIndex = 0;
+            if (_spare)
+                delete_segment(drained);
+            else
+                _spare = drained;
+        }
+    }
+
+  private:
+    struct Segment
+    {
+        Segment* next = nullptr;
+        alignas(T) std::byte storage[sizeof(T) * SegmentSize];
+
+        T* slot(size_t index) noexcept
+        {
+            return reinterpret_cast<T*>(storage) + index;
+        }
+    };
+
+    using SegmentAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Segment>;
+    using SegmentTraits = std::allocator_traits<SegmentAllocator>;
+
+    Segment* new_segment()
+    {
+        auto* segment = SegmentTraits::allocate(_allocator, 1);
+        SegmentTraits::construct(_allocator, segment);
+        return segment;
+    }
+
+    void delete_segment(Segment* segment) noexcept
+    {
+        if (!segment)
+            return;
+        SegmentTraits::destroy(_allocator, segment);
+        SegmentTraits::deallocate(_allocator, segment, 1);
+    }
+
+    [[no_unique_address]] SegmentAllocator _allocator {};
+    Segment* _head = nullptr;
+    Segment* _tail = nullptr;
+    Segment* _spare = nullptr;
+    size_t _headIndex = 0;           // Index of the oldest element within _head.
+    size_t _tailIndex = SegmentSize; // Index one past the newest element within _tail.
+    size_t _size = 0;
+};
+
+} // namespace channel::detail
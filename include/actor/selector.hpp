@@ -0,0 +1,228 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <actor/channel.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace channel
+{
+
+/// Waits on a large, changing set of channels, such as one channel per connected client.
+///
+/// Controller::select() takes a fixed set of channels and rescans all of them on each wakeup. A selector instead
+/// keeps its channels registered across waits, and each channel puts itself onto the selector's ready list when it
+/// receives a value or gets closed. Waiting therefore costs O(ready channels), no matter how many are registered.
+/// Channels may be of different types, and are added and removed at runtime, from any thread.
+///
+/// Readiness is level-triggered: a channel is reported by each wait() for as long as it has values or is closed.
+/// All channels must belong to the selector's controller, and must be removed before they are destroyed.
+/// Only one thread may wait on a selector at a time.
+///
+/// @code
+/// auto selector = channel::Selector { controller };
+/// selector.add(client.inbox, client.id);
+/// for (auto const id: selector.wait())
+///     while (auto request = clients[id].inbox.try_receive())
+///         handle(*request);
+/// @endcode
+class [[nodiscard]] Selector
+{
+  public:
+    /// Identifies a channel in the results of wait(), as chosen by the caller upon adding it.
+    using Key = uint64_t;
+
+    explicit Selector(Controller& controller) noexcept:
+        _controller { controller }
+    {
+    }
+
+    Selector(Selector&&) = delete;
+    Selector(Selector const&) = delete;
+    Selector& operator=(Selector&&) = delete;
+    Selector& operator=(Selector const&) = delete;
+
+    /// Removes all channels.
+    ~Selector();
+
+    /// Adds @p channel, to be reported as @p key.
+    ///
+    /// @throw ControllerMismatchError if the channel belongs to another controller.
+    /// @throw std::invalid_argument if the channel has already been added.
+    template <SelectableChannel C>
+    void add(C& channel, Key key);
+
+    /// Removes @p channel.
+    ///
+    /// @returns false if the channel had not been added.
+    template <SelectableChannel C>
+    bool remove(C& channel);
+
+    /// Returns the number of channels added.
+    [[nodiscard]] size_t size() const;
+
+    /// Blocks until one of the channels has a value or is closed.
+    ///
+    /// @returns the keys of all such channels, valid until the next wait, or none if the controller is terminating.
+    std::span<Key const> wait();
+
+    /// Blocks until one of the channels has a value or is closed, for at most @p timeout.
+    ///
+    /// @returns the keys of all such channels, valid until the next wait, or none if the timeout was reached or the
+    ///          controller is terminating.
+    std::span<Key const> wait_for(std::chrono::milliseconds timeout);
+
+  private:
+    struct Entry: detail::ReadyNode
+    {
+        Key key {};
+        detail::ChannelBase const* channel = nullptr;
+        detail::WaitQueue* queue = nullptr; // The channel's receivers.
+        bool (*readable)(detail::ChannelBase const&) noexcept = nullptr;
+    };
+
+    /// Links @p entry into its channel's wait queue, or moves it to the ready list right away if the channel
+    /// is readable. The mutex must be held.
+    void arm(Entry& entry) noexcept;
+
+    /// Moves the entries on the ready list whose channel is still readable to the reported list, and re-arms the
+    /// others. The mutex must be held.
+    void collect();
+
+    Controller& _controller;
+    detail::Waiter _waiter;
+    detail::ReadyList _ready;    // Entries signalled by their channel, or found readable when armed.
+    detail::ReadyList _reported; // Entries reported by the last wait(), to be re-armed by the next one.
+    std::unordered_map<detail::ChannelBase const*, std::unique_ptr<Entry>> _entries;
+    std::vector<Key> _keys;
+};
+
+// ----------------------------------------------------------------------------
+
+inline Selector::~Selector()
+{
+    auto _ = _controller.acquire();
+    for (auto& [channel, entry]: _entries)
+        entry->queue->remove(*entry);
+}
+
+template <SelectableChannel C>
+void Selector::add(C& channel, Key key)
+{
+    if (&channel.controller() != &_controller)
+        throw ControllerMismatchError {};
+
+    auto entry = std::make_unique<Entry>();
+    entry->waiter = &_waiter;
+    entry->readyList = &_ready;
+    entry->key = key;
+    entry->channel = &channel;
+    entry->queue = &Controller::receivers(channel);
+    entry->readable = [](detail::ChannelBase const& base) noexcept {
+        return Controller::readable(static_cast<C const&>(base));
+    };
+
+    auto _ = _controller.acquire();
+    auto const [i, inserted] = _entries.try_emplace(&channel, std::move(entry));
+    if (!inserted)
+        throw std::invalid_argument("Channel has already been added to the selector");
+    arm(*i->second);
+}
+
+template <SelectableChannel C>
+bool Selector::remove(C& channel)
+{
+    auto _ = _controller.acquire();
+    auto const i = _entries.find(&channel);
+    if (i == _entries.end())
+        return false;
+
+    auto& entry = *i->second;
+    entry.queue->remove(entry);
+    if (entry.list)
+        entry.list->remove(entry);
+    _entries.erase(i);
+    return true;
+}
+
+inline size_t Selector::size() const
+{
+    auto _ = _controller.acquire();
+    return _entries.size();
+}
+
+inline void Selector::arm(Entry& entry) noexcept
+{
+    // Link first and test afterwards, as lock-free channels publish values before checking for waiters.
+    entry.queue->push(entry);
+    if (!entry.readable(*entry.channel))
+        return;
+
+    entry.queue->remove(entry);
+    _ready.push_back(entry);
+    _waiter.signalled = true;
+    _waiter.condition.notify_one();
+}
+
+inline void Selector::collect()
+{
+    while (auto* node = _ready.pop_front())
+    {
+        auto& entry = static_cast<Entry&>(*node);
+        if (!entry.readable(*entry.channel))
+        {
+            arm(entry); // Someone else took the value meanwhile.
+            continue;
+        }
+
+        _reported.push_back(entry);
+        _keys.push_back(entry.key);
+    }
+}
+
+inline std::span<Selector::Key const> Selector::wait()
+{
+    return wait_for(std::chrono::years { 10 });
+}
+
+inline std::span<Selector::Key const> Selector::wait_for(std::chrono::milliseconds timeout)
+{
+    auto lock = _controller.acquire();
+
+    // Channels reported last time are reported again right away if they are still readable.
+    while (auto* node = _reported.pop_front())
+        arm(static_cast<Entry&>(*node));
+
+    _keys.clear();
+    auto const deadline = std::chrono::steady_clock::now() + timeout;
+    auto wakeups = size_t { 0 };
+    auto spuriousWakeups = size_t { 0 };
+    while (!_controller.terminating())
+    {
+        _waiter.signalled = false;
+        collect();
+        if (!_keys.empty())
+            break;
+
+        if (wakeups != 0)
+            ++spuriousWakeups;
+        if (!_waiter.condition.wait_until(lock, deadline, [this]() { return _waiter.signalled.load(); }))
+            break;
+        ++wakeups;
+    }
+
+    _controller._metrics.woken_up(wakeups, spuriousWakeups);
+    if (_controller.terminating())
+        _keys.clear();
+    return _keys;
+}
+
+} // namespace channel
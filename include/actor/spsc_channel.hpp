@@ -0,0 +1,392 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <actor/cache_line.hpp>
+#include <actor/channel.hpp>
+#include <actor/wait_strategy.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace channel
+{
+
+/// Channel for exactly one sending and one receiving thread.
+///
+/// Values are passed through a lock-free ring buffer with the producer's and consumer's indices on separate
+/// cache lines. The controller's mutex is only taken to park when the channel is full (sender) or empty
+/// (receiver), and to wake up the other side if, and only if, it is parked.
+///
+/// The channel can be used with Controller::select, in which case the selecting thread counts as the receiver.
+/// It cannot be sent to through select_case() (see SendSelectableChannel), which would add a second producer.
+///
+/// @code
+/// auto controller = channel::Controller {};
+/// auto channel = channel::SpscChannel<int> { channel::MessageBufferSize { 1024 }, &controller };
+/// std::thread { [&channel] { channel.send(42); } }.detach();
+/// std::cout << channel.receive().value() << std::endl;
+/// @endcode
+template <typename T>
+class [[nodiscard]] SpscChannel: public detail::ChannelBase
+{
+    friend class Controller;
+
+  public:
+    using value_type = T;
+
+    /// The number of times to poll the other side before parking (on multi-core machines only), unless another
+    /// wait strategy is set for receivers.
+    static constexpr int SpinCount = 128;
+
+    /// Constructs a channel with a maximum buffer size.
+    ///
+    /// @param maxBufferSize The maximum buffer size of the channel.
+    /// @param controller The controller to use for the channel.
+    /// @param name The name of the channel.
+    ///
+    /// @note If no controller is provided, a new (internally owned) controller will be created.
+    /// @throw std::invalid_argument for rendezvous and unbounded buffer sizes, which only Channel supports.
+    explicit SpscChannel(MessageBufferSize maxBufferSize = { 1 },
+                         Controller* controller = nullptr,
+                         std::string name = {});
+
+    SpscChannel(SpscChannel&&) = delete;
+    SpscChannel(SpscChannel const&) = delete;
+    SpscChannel& operator=(SpscChannel&&) = delete;
+    SpscChannel& operator=(SpscChannel const&) = delete;
+    ~SpscChannel();
+
+    /// Retrieves the controller associated with the channel.
+    [[nodiscard]] Controller const& controller() const noexcept
+    {
+        return *_controller;
+    }
+
+    /// Retrieves the channel name, useful for introspection/debugging purposes.
+    [[nodiscard]] std::string const& name() const noexcept
+    {
+        return _name;
+    }
+
+    /// Returns the maximum buffer size of the channel.
+    [[nodiscard]] size_t capacity() const noexcept
+    {
+        return _maxBufferSize.value;
+    }
+
+    /// Returns true if the channel is empty, false otherwise.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    /// Returns the current buffer size of the channel.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return _producer.tail.load() - _consumer.head.load();
+    }
+
+    /// Sends a message to the channel. Must only be called by the sending thread.
+    ///
+    /// If the channel is full, the caller will be blocked until the message can be sent.
+    /// If the channel gets closed while being full, the message is discarded.
+    template <typename U>
+        requires std::convertible_to<U, T>
+    void send(U&& value);
+
+    /// Sends a message to the channel, blocking for at most @p timeout while it is full.
+    /// Must only be called by the sending thread.
+    ///
+    /// @returns true if the message was sent, false if the timeout was reached or the channel got closed.
+    ///          @p value is left untouched then.
+    template <typename U, typename Rep, typename Period>
+        requires std::convertible_to<U, T>
+    bool send_for(U&& value, std::chrono::duration<Rep, Period> timeout)
+    {
+        return send_until(std::forward<U>(value), std::chrono::steady_clock::now() + timeout);
+    }
+
+    /// Sends a message to the channel, blocking until @p deadline at the latest while it is full.
+    /// Must only be called by the sending thread.
+    ///
+    /// @returns true if the message was sent, false if the deadline was reached or the channel got closed.
+    ///          @p value is left untouched then.
+    template <typename U, typename Clock, typename Duration>
+        requires std::convertible_to<U, T>
+    bool send_until(U&& value, std::chrono::time_point<Clock, Duration> deadline);
+
+    /// Receives a message from the channel. Must only be called by the receiving thread.
+    ///
+    /// If the channel is empty, the caller will be blocked until a message is available.
+    /// If the channel is closed, std::nullopt will be returned.
+    [[nodiscard]] std::optional<T> receive();
+
+    /// Receives a message from the channel, blocking for at most @p timeout while it is empty.
+    /// Must only be called by the receiving thread.
+    ///
+    /// @returns the received message, or std::nullopt if the timeout was reached or the channel is closed.
+    template <typename Rep, typename Period>
+    [[nodiscard]] std::optional<T> receive_for(std::chrono::duration<Rep, Period> timeout)
+    {
+        return receive_until(std::chrono::steady_clock::now() + timeout);
+    }
+
+    /// Receives a message from the channel, blocking until @p deadline at the latest while it is empty.
+    /// Must only be called by the receiving thread.
+    ///
+    /// @returns the received message, or std::nullopt if the deadline was reached or the channel is closed.
+    template <typename Clock, typename Duration>
+    [[nodiscard]] std::optional<T> receive_until(std::chrono::time_point<Clock, Duration> deadline);
+
+    /// Tries to receive a value without blocking, returning std::nullopt if no value is available.
+    /// Must only be called by the receiving thread.
+    [[nodiscard]] std::optional<T> try_receive();
+
+    /// Closes the channel.
+    void close() noexcept;
+
+    /// Returns how receivers wait for a value before parking.
+    [[nodiscard]] actor::WaitStrategy wait_strategy() const noexcept
+    {
+        return _consumer.spinner.strategy();
+    }
+
+    /// Sets how receivers wait for a value before parking, which is WaitStrategy::spin_then_park(SpinCount, 0)
+    /// by default. Must not be called while a receiver waits.
+    void set_wait_strategy(actor::WaitStrategy strategy) noexcept
+    {
+        _consumer.spinner = actor::detail::Spinner { strategy };
+    }
+
+  private:
+    [[nodiscard]] size_t pending() const noexcept
+    {
+        return size();
+    }
+
+    [[nodiscard]] bool closed() const noexcept
+    {
+        return _terminating.load();
+    }
+
+    /// Tests whether a value can be sent without blocking.
+    [[nodiscard]] bool writable() const noexcept
+    {
+        return size() < _maxBufferSize.value && !closed();
+    }
+
+    /// Takes the oldest value, which must be available, on behalf of a select holding the controller's mutex.
+    [[nodiscard]] T take_locked();
+
+    /// Wakes up one thread of @p queue, if any is waiting.
+    void wakeup(detail::WaitQueue& queue);
+
+    /// Returns the index mask of a ring buffer holding at least @p maxBufferSize values.
+    static size_t ring_mask(MessageBufferSize maxBufferSize);
+
+    // Written by the sender only.
+    struct alignas(actor::CacheLineSize) Producer
+    {
+        std::atomic<size_t> tail = 0;
+        size_t cachedHead = 0;
+    };
+
+    // Written by the receiver only.
+    struct alignas(actor::CacheLineSize) Consumer
+    {
+        std::atomic<size_t> head = 0;
+        size_t cachedTail = 0;
+        actor::detail::Spinner spinner { actor::WaitStrategy::spin_then_park(SpinCount, 0) };
+    };
+
+    Producer _producer;
+    Consumer _consumer;
+    std::unique_ptr<Controller> _ownedController;
+    Controller* _controller;
+    MessageBufferSize _maxBufferSize;
+    size_t _mask;
+    T* _slots;
+    std::atomic<bool> _terminating = false;
+    std::string _name;
+};
+
+// ----------------------------------------------------------------------------
+
+template <typename T>
+size_t SpscChannel<T>::ring_mask(MessageBufferSize maxBufferSize)
+{
+    if (maxBufferSize.value == MessageBufferSize::rendezvous().value
+        || maxBufferSize.value == MessageBufferSize::unbounded().value)
+        throw std::invalid_argument("SpscChannel requires a bounded, non-zero buffer size");
+
+    return detail::ring_capacity<T>(maxBufferSize.value) - 1;
+}
+
+template <typename T>
+SpscChannel<T>::SpscChannel(MessageBufferSize maxBufferSize, Controller* controller, std::string name):
+    _ownedController { controller ? nullptr : std::make_unique<Controller>() },
+    _controller { controller ? controller : _ownedController.get() },
+    _maxBufferSize { maxBufferSize },
+    _mask { ring_mask(maxBufferSize) },
+    _slots { std::allocator<T> {}.allocate(_mask + 1) },
+    _name { std::move(name) }
+{
+    _controller->attach(*this);
+}
+
+template <typename T>
+SpscChannel<T>::~SpscChannel()
+{
+    close();
+    _controller->detach(*this);
+
+    for (auto i = _consumer.head.load(); i != _producer.tail.load(); ++i)
+        std::destroy_at(_slots + (i & _mask));
+    std::allocator<T> {}.deallocate(_slots, _mask + 1);
+}
+
+template <typename T>
+void SpscChannel<T>::wakeup(detail::WaitQueue& queue)
+{
+    // The caller published its progress with a sequentially consistent store, and a waiter registers itself
+    // before re-checking the channel state, so either we see the waiter or the waiter sees our progress.
+    if (queue.waiting() == 0)
+        return;
+
+    auto _ = _controller->acquire();
+    queue.notify_one();
+}
+
+template <typename T>
+template <typename U>
+    requires std::convertible_to<U, T>
+void SpscChannel<T>::send(U&& value)
+{
+    send_until(std::forward<U>(value), std::chrono::steady_clock::time_point::max());
+}
+
+template <typename T>
+template <typename U, typename Clock, typename Duration>
+    requires std::convertible_to<U, T>
+bool SpscChannel<T>::send_until(U&& value, std::chrono::time_point<Clock, Duration> deadline)
+{
+    auto const tail = _producer.tail.load(std::memory_order_relaxed);
+    auto const hasSpace = [&]() {
+        if (tail - _producer.cachedHead < _maxBufferSize.value)
+            return true;
+        _producer.cachedHead = _consumer.head.load(std::memory_order_acquire);
+        return tail - _producer.cachedHead < _maxBufferSize.value;
+    };
+
+    if (!hasSpace())
+    {
+        for (int i = 0; actor::detail::can_spin() && i < SpinCount && !hasSpace() && !closed(); ++i)
+            actor::detail::cpu_relax();
+
+        if (!hasSpace())
+        {
+            auto lock = _controller->acquire();
+            _controller->wait_until(
+                lock, std::array { &_senders }, deadline, [&]() { return hasSpace() || closed(); });
+            if (!hasSpace())
+                return false; // The deadline was reached or the channel was closed while waiting for free space.
+        }
+    }
+
+    std::construct_at(_slots + (tail & _mask), std::forward<U>(value));
+    _producer.tail.store(tail + 1);
+    wakeup(_receivers);
+    return true;
+}
+
+template <typename T>
+std::optional<T> SpscChannel<T>::try_receive()
+{
+    auto const head = _consumer.head.load(std::memory_order_relaxed);
+    if (head == _consumer.cachedTail)
+    {
+        _consumer.cachedTail = _producer.tail.load(std::memory_order_acquire);
+        if (head == _consumer.cachedTail)
+            return std::nullopt;
+    }
+
+    auto* slot = _slots + (head & _mask);
+    auto value = std::optional<T> { std::move(*slot) };
+    std::destroy_at(slot);
+    _consumer.head.store(head + 1);
+    wakeup(_senders);
+    return value;
+}
+
+template <typename T>
+T SpscChannel<T>::take_locked()
+{
+    // Refreshing the cached tail synchronizes with the producer's write of the slot, and keeps the cached tail
+    // from falling behind the head, which try_receive() relies on.
+    auto const head = _consumer.head.load(std::memory_order_relaxed);
+    _consumer.cachedTail = _producer.tail.load(std::memory_order_acquire);
+
+    auto* slot = _slots + (head & _mask);
+    auto value = std::move(*slot);
+    std::destroy_at(slot);
+    _consumer.head.store(head + 1);
+    _senders.notify_one(); // The mutex is held already, so unlike wakeup(), this must not lock it.
+    return value;
+}
+
+template <typename T>
+std::optional<T> SpscChannel<T>::receive()
+{
+    return receive_until(std::chrono::steady_clock::time_point::max());
+}
+
+template <typename T>
+template <typename Clock, typename Duration>
+std::optional<T> SpscChannel<T>::receive_until(std::chrono::time_point<Clock, Duration> deadline)
+{
+    while (true)
+    {
+        if (auto value = try_receive())
+            return value;
+
+        auto const waitStart = _consumer.spinner.start();
+        if (_consumer.spinner.spin(waitStart, deadline, [this]() { return !empty() || closed(); }) && !empty())
+            continue;
+
+        if (closed())
+            return try_receive();
+
+        auto lock = _controller->acquire();
+        auto const woken = _controller->wait_until(
+            lock, std::array { &_receivers }, deadline, [this]() { return !empty() || closed(); });
+        _consumer.spinner.parked(waitStart);
+        if (!woken)
+            return std::nullopt;
+    }
+}
+
+template <typename T>
+void SpscChannel<T>::close() noexcept
+{
+    auto _ = _controller->acquire();
+
+    auto const wasClosedBefore = _terminating.exchange(true);
+    if (wasClosedBefore)
+        return;
+
+    if (--_controller->_channelCount == 0)
+        _controller->notify_all_locked(); // wake up selects that wait for the controller to die
+    else
+    {
+        _senders.notify_all();
+        _receivers.notify_all();
+    }
+}
+
+} // namespace channel
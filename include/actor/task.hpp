@@ -0,0 +1,266 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <actor/executor.hpp>
+
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <utility>
+#include <variant>
+
+namespace actor
+{
+
+template <typename T = void>
+class Task;
+
+namespace detail
+{
+    /// Resumes the awaiting coroutine, if any, once a task has completed.
+    struct TaskPromiseBase
+    {
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            template <typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+            {
+                if (auto continuation = handle.promise().continuation)
+                    return continuation;
+                return std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        std::suspend_always initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        FinalAwaiter final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        std::coroutine_handle<> continuation;
+    };
+
+    template <typename T>
+    struct TaskPromise: TaskPromiseBase
+    {
+        Task<T> get_return_object() noexcept;
+
+        template <typename U>
+            requires std::convertible_to<U, T>
+        void return_value(U&& value)
+        {
+            result.template emplace<1>(std::forward<U>(value));
+        }
+
+        void unhandled_exception() noexcept
+        {
+            result.template emplace<2>(std::current_exception());
+        }
+
+        T take_result()
+        {
+            if (result.index() == 2)
+                std::rethrow_exception(std::get<2>(result));
+            return std::move(std::get<1>(result));
+        }
+
+        std::variant<std::monostate, T, std::exception_ptr> result;
+    };
+
+    template <>
+    struct TaskPromise<void>: TaskPromiseBase
+    {
+        Task<void> get_return_object() noexcept;
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept
+        {
+            exception = std::current_exception();
+        }
+
+        void take_result()
+        {
+            if (exception)
+                std::rethrow_exception(exception);
+        }
+
+        std::exception_ptr exception;
+    };
+
+    /// Fire-and-forget coroutine that destroys itself upon completion.
+    struct DetachedTask
+    {
+        struct promise_type
+        {
+            DetachedTask get_return_object() const noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void return_void() const noexcept {}
+
+            [[noreturn]] void unhandled_exception() const noexcept
+            {
+                std::terminate();
+            }
+        };
+    };
+} // namespace detail
+
+/// A lazily started coroutine producing a value of type @p T.
+///
+/// The coroutine starts running when the task is awaited, and the awaiting coroutine is resumed
+/// (by symmetric transfer, without going through the executor) once it has completed.
+/// Exceptions escaping the coroutine are rethrown to the awaiting coroutine.
+///
+/// @code
+/// actor::Task<int> answer() { co_return 42; }
+/// actor::Task<> printer() { std::cout << co_await answer() << '\n'; }
+/// actor::spawn(executor, printer());
+/// @endcode
+template <typename T>
+class [[nodiscard]] Task
+{
+  public:
+    using promise_type = detail::TaskPromise<T>;
+
+    Task(Task&& other) noexcept:
+        _handle { std::exchange(other._handle, nullptr) }
+    {
+    }
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (_handle)
+                _handle.destroy();
+            _handle = std::exchange(other._handle, nullptr);
+        }
+        return *this;
+    }
+
+    Task(Task const&) = delete;
+    Task& operator=(Task const&) = delete;
+
+    ~Task()
+    {
+        if (_handle)
+            _handle.destroy();
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+    {
+        _handle.promise().continuation = continuation;
+        return _handle;
+    }
+
+    T await_resume()
+    {
+        return _handle.promise().take_result();
+    }
+
+  private:
+    friend promise_type;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept:
+        _handle { handle }
+    {
+    }
+
+    std::coroutine_handle<promise_type> _handle;
+};
+
+/// Suspends the calling coroutine and resumes it on one of the workers of @p executor.
+///
+/// @code
+/// co_await actor::resume_on(executor);
+/// @endcode
+class [[nodiscard]] ResumeOn: private Runnable
+{
+  public:
+    explicit ResumeOn(Executor& executor) noexcept:
+        _executor { executor }
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        _handle = handle;
+        _executor.schedule(*this);
+    }
+
+    void await_resume() const noexcept {}
+
+  private:
+    void run() override
+    {
+        _handle.resume();
+    }
+
+    Executor& _executor;
+    std::coroutine_handle<> _handle;
+};
+
+inline ResumeOn resume_on(Executor& executor) noexcept
+{
+    return ResumeOn { executor };
+}
+
+/// Runs @p task on @p executor without waiting for its completion.
+///
+/// @note An exception escaping @p task terminates the program, just like one escaping a thread does.
+inline void spawn(Executor& executor, Task<> task)
+{
+    [](Executor& executor, Task<> task) -> detail::DetachedTask {
+        co_await resume_on(executor);
+        co_await std::move(task);
+    }(executor, std::move(task));
+}
+
+// ----------------------------------------------------------------------------
+
+template <typename T>
+Task<T> detail::TaskPromise<T>::get_return_object() noexcept
+{
+    return Task<T> { std::coroutine_handle<TaskPromise>::from_promise(*this) };
+}
+
+inline Task<void> detail::TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void> { std::coroutine_handle<TaskPromise>::from_promise(*this) };
+}
+
+} // namespace actor
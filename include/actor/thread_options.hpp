@@ -0,0 +1,295 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+    #include <linux/mempolicy.h>
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace actor
+{
+
+/// The scheduling policy of a thread, see sched(7).
+enum class SchedulingPolicy
+{
+    /// Keeps the policy of the thread that starts the thread.
+    Inherit,
+    /// The default time-sharing policy (SCHED_OTHER).
+    Other,
+    /// Time-sharing, for CPU-bound threads that should not preempt interactive ones (SCHED_BATCH).
+    Batch,
+    /// Runs only when nothing else would (SCHED_IDLE).
+    Idle,
+    /// Real-time, first in first out (SCHED_FIFO). Typically requires CAP_SYS_NICE.
+    Fifo,
+    /// Real-time, round-robin (SCHED_RR). Typically requires CAP_SYS_NICE.
+    RoundRobin,
+};
+
+/// Configures the placement and scheduling of a thread started by an actor or executor.
+///
+/// Cooperating actors, such as the stages of a pipeline, share caches if they are given the same CPUs, e.g. those
+/// returned by cache_sibling_cpus() or numa_node_cpus().
+///
+/// Only supported on Linux. Elsewhere, any option other than the name fails the thread's start.
+struct ThreadOptions
+{
+    /// The thread's name, as shown by debuggers and top. Truncated to 15 characters.
+    std::string name {};
+
+    /// The CPUs the thread may run on, or all if empty.
+    std::vector<unsigned> cpus {};
+
+    /// The NUMA node to run on, further restricted to @c cpus if set. Memory that the thread touches first is
+    /// preferably taken from this node, which includes the actor's mailbox nodes.
+    std::optional<unsigned> numaNode {};
+
+    SchedulingPolicy policy = SchedulingPolicy::Inherit;
+
+    /// The static priority, which must be between 1 and 99 for the real-time policies and 0 otherwise.
+    int priority = 0;
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return name.empty() && cpus.empty() && !numaNode && policy == SchedulingPolicy::Inherit;
+    }
+};
+
+/// Returns the CPUs of NUMA node @p node in ascending order, or none if there is no such node.
+[[nodiscard]] std::vector<unsigned> numa_node_cpus(unsigned node);
+
+/// Returns the CPUs sharing the largest cache with @p cpu (which includes @p cpu itself) in ascending order,
+/// or none if the cache topology is unknown.
+///
+/// @throw std::invalid_argument if sysfs reports a malformed cache level or CPU list.
+[[nodiscard]] std::vector<unsigned> cache_sibling_cpus(unsigned cpu);
+
+namespace detail
+{
+    /// Parses a list of CPUs or nodes as found in sysfs, such as "0-3,8,10-11".
+    ///
+    /// @throw std::invalid_argument if @p list is malformed.
+    [[nodiscard]] std::vector<unsigned> parse_cpu_list(std::string_view list);
+
+    /// Reads the first line of a sysfs file, or returns std::nullopt if it cannot be read.
+    [[nodiscard]] std::optional<std::string> read_sysfs(std::filesystem::path const& path);
+
+    /// Applies @p options to the calling thread.
+    ///
+    /// @throw std::invalid_argument if a CPU or node does not exist, or the CPUs are not on the node.
+    /// @throw std::system_error if the system refuses an option, e.g. for lack of privileges.
+    void apply(ThreadOptions const& options);
+
+    /// Starts a thread that applies @p options to itself before running @p body.
+    ///
+    /// Waits until the options have been applied, so that failures surface in the calling thread.
+    ///
+    /// @throw as apply(), in which case @p body is not run.
+    template <typename F>
+    std::thread start_thread(ThreadOptions const& options, F&& body);
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+
+inline std::vector<unsigned> detail::parse_cpu_list(std::string_view list)
+{
+    auto const parse = [list](std::string_view number) {
+        auto value = 0U;
+        auto const [end, error] = std::from_chars(number.data(), number.data() + number.size(), value);
+        if (error != std::errc {} || end != number.data() + number.size())
+            throw std::invalid_argument("Malformed CPU list: " + std::string(list));
+        return value;
+    };
+
+    auto cpus = std::vector<unsigned> {};
+    while (!list.empty() && (list.back() == '\n' || list.back() == ' '))
+        list.remove_suffix(1);
+    while (!list.empty())
+    {
+        auto const comma = list.find(',');
+        auto const range = list.substr(0, comma);
+        list = comma == std::string_view::npos ? std::string_view {} : list.substr(comma + 1);
+
+        auto const dash = range.find('-');
+        auto const first = parse(range.substr(0, dash));
+        auto const last = dash == std::string_view::npos ? first : parse(range.substr(dash + 1));
+        for (auto cpu = first; cpu <= last; ++cpu)
+            cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+inline std::optional<std::string> detail::read_sysfs(std::filesystem::path const& path)
+{
+    auto file = std::ifstream { path };
+    auto line = std::string {};
+    if (!std::getline(file, line))
+        return std::nullopt;
+    return line;
+}
+
+inline std::vector<unsigned> numa_node_cpus(unsigned node)
+{
+    auto const list = detail::read_sysfs("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    return list ? detail::parse_cpu_list(*list) : std::vector<unsigned> {};
+}
+
+inline std::vector<unsigned> cache_sibling_cpus(unsigned cpu)
+{
+    auto const caches = std::filesystem::path { "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cache" };
+    auto error = std::error_code {};
+    auto level = 0;
+    auto siblings = std::vector<unsigned> {};
+    for (auto const& entry: std::filesystem::directory_iterator { caches, error })
+    {
+        if (!entry.path().filename().string().starts_with("index"))
+            continue;
+
+        auto const levelText = detail::read_sysfs(entry.path() / "level");
+        auto const list = detail::read_sysfs(entry.path() / "shared_cpu_list");
+        if (!levelText || !list)
+            continue;
+
+        auto entryLevel = 0;
+        auto const [end, parseError] =
+            std::from_chars(levelText->data(), levelText->data() + levelText->size(), entryLevel);
+        if (parseError != std::errc {} || end != levelText->data() + levelText->size())
+            throw std::invalid_argument("Malformed cache level: " + *levelText);
+        if (entryLevel <= level)
+            continue;
+
+        level = entryLevel;
+        siblings = detail::parse_cpu_list(*list);
+    }
+    return siblings;
+}
+
+inline void detail::apply(ThreadOptions const& options)
+{
+#if defined(__linux__)
+    if (!options.name.empty())
+    {
+        auto const name = options.name.substr(0, 15);
+        if (auto const error = pthread_setname_np(pthread_self(), name.c_str()))
+            throw std::system_error(error, std::system_category(), "Cannot set thread name");
+    }
+
+    auto cpus = options.cpus;
+    if (options.numaNode)
+    {
+        auto const nodeCpus = numa_node_cpus(*options.numaNode);
+        if (nodeCpus.empty())
+            throw std::invalid_argument("No such NUMA node: " + std::to_string(*options.numaNode));
+
+        if (cpus.empty())
+            cpus = nodeCpus;
+        else
+            std::erase_if(cpus, [&](unsigned cpu) { return !std::ranges::binary_search(nodeCpus, cpu); });
+        if (cpus.empty())
+            throw std::invalid_argument("None of the CPUs is on NUMA node " + std::to_string(*options.numaNode));
+
+        // Prefer (rather than bind to) the node, so that allocations still succeed once it runs out of memory.
+        constexpr auto BitsPerWord = sizeof(unsigned long) * 8;
+        auto nodeMask = std::vector<unsigned long>(*options.numaNode / BitsPerWord + 1);
+        nodeMask[*options.numaNode / BitsPerWord] = 1UL << (*options.numaNode % BitsPerWord);
+        if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, nodeMask.data(), nodeMask.size() * BitsPerWord + 1) != 0)
+            throw std::system_error(errno, std::system_category(), "Cannot set NUMA memory policy");
+    }
+
+    if (!cpus.empty())
+    {
+        auto cpuSet = cpu_set_t {};
+        CPU_ZERO(&cpuSet);
+        for (auto const cpu: cpus)
+        {
+            if (cpu >= CPU_SETSIZE)
+                throw std::invalid_argument("No such CPU: " + std::to_string(cpu));
+            CPU_SET(cpu, &cpuSet);
+        }
+        if (auto const error = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet))
+            throw std::system_error(error, std::system_category(), "Cannot set CPU affinity");
+    }
+
+    if (options.policy != SchedulingPolicy::Inherit)
+    {
+        auto const policy = [&]() {
+            switch (options.policy)
+            {
+                case SchedulingPolicy::Batch:
+                    return SCHED_BATCH;
+                case SchedulingPolicy::Idle:
+                    return SCHED_IDLE;
+                case SchedulingPolicy::Fifo:
+                    return SCHED_FIFO;
+                case SchedulingPolicy::RoundRobin:
+                    return SCHED_RR;
+                default:
+                    return SCHED_OTHER;
+            }
+        }();
+        auto const parameters = sched_param { .sched_priority = options.priority };
+        if (auto const error = pthread_setschedparam(pthread_self(), policy, &parameters))
+            throw std::system_error(error, std::system_category(), "Cannot set scheduling policy");
+    }
+#else
+    if (!options.cpus.empty() || options.numaNode || options.policy != SchedulingPolicy::Inherit)
+        throw std::system_error(std::make_error_code(std::errc::not_supported), "Thread placement");
+#endif
+}
+
+template <typename F>
+std::thread detail::start_thread(ThreadOptions const& options, F&& body)
+{
+    if (options.empty())
+        return std::thread { std::forward<F>(body) };
+
+    auto applied = std::promise<void> {};
+    auto result = applied.get_future();
+    // The thread owns the promise, as it may still be touching it when the caller sees the result.
+    auto thread = std::thread { [&options, applied = std::move(applied), body = std::forward<F>(body)]() mutable {
+        try
+        {
+            apply(options);
+        }
+        catch (...)
+        {
+            applied.set_exception(std::current_exception());
+            return;
+        }
+        applied.set_value();
+        body();
+    } };
+
+    try
+    {
+        result.get();
+    }
+    catch (...)
+    {
+        thread.join();
+        throw;
+    }
+    return thread;
+}
+
+} // namespace actor
@@ -0,0 +1,243 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace actor
+{
+
+/// Identifies a timer scheduled on a TimerWheel.
+enum class TimerId : uint64_t
+{
+};
+
+/// Runs callbacks after a delay, using a single thread for any number of timers.
+///
+/// Timers are kept in a hashed timing wheel: a ring of slots, each covering one tick of the wheel's resolution.
+/// Scheduling and cancelling take constant time, and timers further away than one revolution simply stay in
+/// their slot for more revolutions. The thread sleeps until the next non-empty slot, and not at all while no
+/// timer is pending. Timers fire no earlier than their deadline, and at most one tick later.
+///
+/// Callbacks run on the wheel's thread, so they should be short, such as sending a message to an actor:
+///
+/// @code
+/// auto timers = actor::TimerWheel {};
+/// timers.send_after(worker, std::chrono::seconds(5), actor::Message { Timeout {} });
+/// @endcode
+class TimerWheel
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::move_only_function<void()>;
+
+    /// The default number of slots, which is rounded up to a power of two.
+    static constexpr size_t DefaultSlotCount = 512;
+
+    /// Constructs a timer wheel ticking every @p resolution, and starts its thread.
+    explicit TimerWheel(Clock::duration resolution = std::chrono::milliseconds(1),
+                        size_t slotCount = DefaultSlotCount);
+
+    TimerWheel(TimerWheel&&) = delete;
+    TimerWheel(TimerWheel const&) = delete;
+    TimerWheel& operator=(TimerWheel&&) = delete;
+    TimerWheel& operator=(TimerWheel const&) = delete;
+
+    /// Joins the wheel's thread. Pending timers are discarded without being run.
+    ~TimerWheel();
+
+    /// Runs @p callback once @p deadline has passed.
+    TimerId schedule_at(Clock::time_point deadline, Callback callback);
+
+    /// Runs @p callback once @p delay has passed.
+    TimerId schedule_after(Clock::duration delay, Callback callback)
+    {
+        return schedule_at(Clock::now() + delay, std::move(callback));
+    }
+
+    /// Sends @p message to @p actor once @p delay has passed.
+    ///
+    /// @note The actor must outlive the timer, or the timer must be cancelled before the actor is destroyed.
+    template <typename A, typename M>
+        requires requires(A& actor, M message) { actor.send(std::move(message)); }
+    TimerId send_after(A& actor, Clock::duration delay, M message)
+    {
+        return schedule_after(delay,
+                              [&actor, message = std::move(message)]() mutable { actor.send(std::move(message)); });
+    }
+
+    /// Cancels the timer @p id.
+    ///
+    /// @returns true if the timer was cancelled, false if it has already fired (or is firing right now).
+    bool cancel(TimerId id);
+
+    /// Returns the number of timers that have not fired yet.
+    [[nodiscard]] size_t pending() const;
+
+  private:
+    struct Timer
+    {
+        TimerId id;
+        uint64_t tick;
+        Callback callback;
+    };
+
+    void run();
+
+    /// Moves all timers due at @p now out of the slots into @p expired. The mutex must be held.
+    void collect(uint64_t now, std::vector<Timer>& expired);
+
+    /// Returns the number of whole ticks between the wheel's epoch and @p time.
+    [[nodiscard]] uint64_t ticks_until(Clock::time_point time) const noexcept
+    {
+        return time <= _epoch ? 0 : static_cast<uint64_t>((time - _epoch) / _resolution);
+    }
+
+    Clock::duration const _resolution;
+    Clock::time_point const _epoch;
+    std::vector<std::vector<Timer>> _slots;
+    uint64_t _mask;
+    std::unordered_map<TimerId, uint64_t> _ticks; // The tick of each pending timer.
+    uint64_t _processedTick = 0;                  // All timers due up to this tick have been fired.
+    uint64_t _wakeTick = std::numeric_limits<uint64_t>::max(); // The tick the thread sleeps until.
+    uint64_t _nextId = 0;
+    bool _stopping = false;
+    mutable std::mutex _mutex;
+    std::condition_variable _condition;
+    std::thread _thread; // Must be last, as it starts running upon construction.
+};
+
+// ----------------------------------------------------------------------------
+
+inline TimerWheel::TimerWheel(Clock::duration resolution, size_t slotCount):
+    _resolution { std::max(resolution, Clock::duration { 1 }) },
+    _epoch { Clock::now() },
+    _slots(std::bit_ceil(std::max<size_t>(1, slotCount))),
+    _mask { _slots.size() - 1 },
+    _thread { [this]() { run(); } }
+{
+}
+
+inline TimerWheel::~TimerWheel()
+{
+    {
+        auto _ = std::unique_lock { _mutex };
+        _stopping = true;
+        _condition.notify_all();
+    }
+    _thread.join();
+}
+
+inline TimerId TimerWheel::schedule_at(Clock::time_point deadline, Callback callback)
+{
+    auto _ = std::unique_lock { _mutex };
+
+    // Round up, so that the timer never fires early.
+    auto tick = ticks_until(deadline);
+    if (_epoch + tick * _resolution < deadline)
+        ++tick;
+    tick = std::max(tick, _processedTick + 1);
+
+    auto const id = TimerId { ++_nextId };
+    _slots[tick & _mask].push_back(Timer { id, tick, std::move(callback) });
+    _ticks.emplace(id, tick);
+
+    // Make the thread give up its current sleep target, which its wait predicate checks for.
+    if (tick < _wakeTick)
+    {
+        _wakeTick = tick;
+        _condition.notify_one();
+    }
+
+    return id;
+}
+
+inline bool TimerWheel::cancel(TimerId id)
+{
+    auto cancelled = Callback {}; // Destroyed after unlocking, in case its destructor uses this wheel.
+    auto _ = std::unique_lock { _mutex };
+
+    auto const i = _ticks.find(id);
+    if (i == _ticks.end())
+        return false;
+
+    auto& slot = _slots[i->second & _mask];
+    auto const timer = std::ranges::find(slot, id, &Timer::id);
+    cancelled = std::move(timer->callback);
+    *timer = std::move(slot.back());
+    slot.pop_back();
+    _ticks.erase(i);
+    return true;
+}
+
+inline size_t TimerWheel::pending() const
+{
+    auto _ = std::unique_lock { _mutex };
+    return _ticks.size();
+}
+
+inline void TimerWheel::collect(uint64_t now, std::vector<Timer>& expired)
+{
+    // Visit each slot between the last processed tick and now, but each one at most once,
+    // as a slot also holds the timers of later revolutions.
+    auto const last = std::min(now, _processedTick + _slots.size());
+    for (auto tick = _processedTick + 1; tick <= last; ++tick)
+    {
+        auto& slot = _slots[tick & _mask];
+        auto const due = std::ranges::partition(slot, [now](Timer const& timer) { return timer.tick > now; });
+        for (auto& timer: due)
+        {
+            _ticks.erase(timer.id);
+            expired.push_back(std::move(timer));
+        }
+        slot.erase(due.begin(), due.end());
+    }
+    _processedTick = std::max(_processedTick, now);
+}
+
+inline void TimerWheel::run()
+{
+    auto expired = std::vector<Timer> {};
+    auto lock = std::unique_lock { _mutex };
+    while (!_stopping)
+    {
+        collect(ticks_until(Clock::now()), expired);
+        if (!expired.empty())
+        {
+            lock.unlock();
+            for (auto& timer: expired)
+                timer.callback();
+            expired.clear();
+            lock.lock();
+            continue;
+        }
+
+        if (_ticks.empty())
+        {
+            _wakeTick = std::numeric_limits<uint64_t>::max();
+            _condition.wait(lock, [this]() { return _stopping || !_ticks.empty(); });
+            continue;
+        }
+
+        // Sleep until the next non-empty slot, which is at most one revolution away.
+        auto next = _processedTick + 1;
+        while (_slots[next & _mask].empty() && next < _processedTick + _slots.size())
+            ++next;
+
+        _wakeTick = next;
+        _condition.wait_until(lock, _epoch + next * _resolution, [&]() { return _stopping || _wakeTick != next; });
+    }
+}
+
+} // namespace actor
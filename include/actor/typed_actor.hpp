@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <actor/actor.hpp>
+#include <actor/actor_core.hpp>
+#include <actor/executor.hpp>
+
+#include <concepts>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace actor
+{
+
+/// Tests whether @p F can handle every one of the message types @p Ts,
+/// either by value/rvalue reference or by lvalue reference.
+template <typename F, typename... Ts>
+concept MessageVisitor = ((std::invocable<F&, Ts&&> || std::invocable<F&, Ts&>) && ...);
+
+/// An actor accepting a closed set of message types @p Ts.
+///
+/// Messages are stored as std::variant<Ts...> directly in the inbox, so there is no type erasure and no
+/// heap allocation per message. Sending a type that is not listed is a compile-time error, and each message
+/// is dispatched to the visitor with a single std::visit rather than a chain of runtime type comparisons.
+///
+/// Like Actor, a typed actor either runs in its own thread or is bound to an Executor.
+///
+/// @code
+/// auto logger = actor::TypedActor<std::string, int> { actor::overloaded {
+///     [](std::string const& s) { std::cout << "str: " << s << '\n'; },
+///     [](int i) { std::cout << "int: " << i << '\n'; },
+/// } };
+/// logger << std::string("Hello") << 42;
+/// @endcode
+template <typename... Ts>
+class TypedActor: public detail::ActorCore<std::variant<Ts...>>
+{
+    using Core = detail::ActorCore<std::variant<Ts...>>;
+
+  public:
+    using message_type = std::variant<Ts...>;
+
+    /// Constructs a thread-backed actor, invoking @p visitor in its own thread for each received message.
+    /// The thread is placed according to @p threadOptions.
+    ///
+    /// @throw as detail::apply() if the thread options cannot be applied.
+    template <typename V>
+        requires MessageVisitor<std::decay_t<V>, Ts...>
+    explicit TypedActor(V&& visitor, MailboxOptions options = {}, ThreadOptions const& threadOptions = {});
+
+    /// Constructs an actor that is scheduled onto @p executor, invoking @p visitor for each received message.
+    ///
+    /// @note The executor must outlive the actor.
+    template <typename V>
+        requires MessageVisitor<std::decay_t<V>, Ts...>
+    TypedActor(Executor& executor, V&& visitor, MailboxOptions options = {});
+
+    TypedActor() = delete;
+
+    /// Sends @p value to this actor. Only the actor's declared message types are accepted.
+    ///
+    /// @returns false if the message was not accepted by a bounded inbox (see Mailbox::push()).
+    template <typename T>
+        requires(std::same_as<std::remove_cvref_t<T>, Ts> || ...)
+    bool send(T&& value, Priority priority = Priority::Normal);
+
+    /// Sends @p value only if the inbox has free space, regardless of its overflow policy.
+    template <typename T>
+        requires(std::same_as<std::remove_cvref_t<T>, Ts> || ...)
+    bool try_send(T&& value, Priority priority = Priority::Normal);
+
+    template <typename T>
+        requires(std::same_as<std::remove_cvref_t<T>, Ts> || ...)
+    TypedActor& operator<<(T&& value);
+
+    /// Sends all elements of @p messages to this actor at once, waking it up (or scheduling it) at most once.
+    template <BatchOf<message_type> R>
+    size_t send_batch(R&& messages, Priority priority = Priority::Normal)
+    {
+        return Core::send_batch(std::forward<R>(messages), priority);
+    }
+
+  private:
+    template <typename V>
+    static void dispatch(V& visitor, message_type& message)
+    {
+        std::visit([&](auto& value) { detail::invoke_consuming(visitor, value); }, message);
+    }
+};
+
+/// Helper to build a visitor from a set of lambdas.
+template <typename... Fs>
+struct overloaded: Fs...
+{
+    using Fs::operator()...;
+};
+
+template <typename... Fs>
+overloaded(Fs...) -> overloaded<Fs...>;
+
+// ----------------------------------------------------------------------------
+
+template <typename... Ts>
+template <typename V>
+    requires MessageVisitor<std::decay_t<V>, Ts...>
+TypedActor<Ts...>::TypedActor(V&& visitor, MailboxOptions options, ThreadOptions const& threadOptions):
+    Core { [visitor = std::forward<V>(visitor)](Core& core) mutable {
+              while (auto message = core.receive())
+                  dispatch(visitor, *message);
+          },
+           options,
+           threadOptions }
+{
+}
+
+template <typename... Ts>
+template <typename V>
+    requires MessageVisitor<std::decay_t<V>, Ts...>
+TypedActor<Ts...>::TypedActor(Executor& executor, V&& visitor, MailboxOptions options):
+    Core { executor,
+           [visitor = std::forward<V>(visitor)](message_type& message) mutable { dispatch(visitor, message); },
+           options }
+{
+}
+
+template <typename... Ts>
+template <typename T>
+    requires(std::same_as<std::remove_cvref_t<T>, Ts> || ...)
+bool TypedActor<Ts...>::send(T&& value, Priority priority)
+{
+    return Core::send(message_type { std::in_place_type<std::remove_cvref_t<T>>, std::forward<T>(value) },
+                      priority);
+}
+
+template <typename... Ts>
+template <typename T>
+    requires(std::same_as<std::remove_cvref_t<T>, Ts> || ...)
+bool TypedActor<Ts...>::try_send(T&& value, Priority priority)
+{
+    return Core::try_send(message_type { std::in_place_type<std::remove_cvref_t<T>>, std::forward<T>(value) },
+                          priority);
+}
+
+template <typename... Ts>
+template <typename T>
+    requires(std::same_as<std::remove_cvref_t<T>, Ts> || ...)
+TypedActor<Ts...>& TypedActor<Ts...>::operator<<(T&& value)
+{
+    send(std::forward<T>(value));
+    return *this;
+}
+
+} // namespace actor
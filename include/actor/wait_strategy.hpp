@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace actor
+{
+
+/// How a receiver waits for a value before parking on a condition variable.
+///
+/// Parking costs a futex call on both sides and the scheduler's wake-up latency, typically tens of microseconds
+/// for each transition from idle to busy. Polling for a while first avoids that if the next value arrives soon,
+/// at the expense of keeping a core busy meanwhile. On single-core machines, polling yields instead of spinning.
+///
+/// @code
+/// auto inbox = actor::MailboxOptions { .wait = actor::WaitStrategy::adaptive() };
+/// channel.set_wait_strategy(actor::WaitStrategy::spin_then_park(2000, 20));
+/// @endcode
+struct WaitStrategy
+{
+    enum class Mode
+    {
+        Park,
+        BusySpin,
+        SpinThenPark,
+        Adaptive,
+    };
+
+    Mode mode = Mode::Park;
+
+    /// SpinThenPark: the number of polls with a pause instruction in between, before yielding.
+    uint32_t spins = 0;
+
+    /// SpinThenPark: the number of polls with std::this_thread::yield() in between, before parking.
+    uint32_t yields = 0;
+
+    /// Adaptive: the longest time to poll for.
+    std::chrono::nanoseconds spinLimit {};
+
+    /// Parks right away, which keeps idle receivers off the CPU. The default.
+    static constexpr WaitStrategy park() noexcept
+    {
+        return {};
+    }
+
+    /// Polls until a value arrives, the deadline is reached or the queue is closed, and never parks.
+    /// Gives the lowest latency, but keeps a core busy for as long as the receiver waits.
+    static constexpr WaitStrategy busy_spin() noexcept
+    {
+        return { .mode = Mode::BusySpin };
+    }
+
+    /// Polls @p spins times, then yields @p yields times, then parks.
+    static constexpr WaitStrategy spin_then_park(uint32_t spins = 1000, uint32_t yields = 10) noexcept
+    {
+        return { .mode = Mode::SpinThenPark, .spins = spins, .yields = yields };
+    }
+
+    /// Polls for twice the average of the receiver's recent waits, then parks. Once that exceeds @p spinLimit,
+    /// the receiver parks right away, until values arrive closer together again.
+    static constexpr WaitStrategy adaptive(
+        std::chrono::nanoseconds spinLimit = std::chrono::microseconds { 50 }) noexcept
+    {
+        return { .mode = Mode::Adaptive, .spinLimit = spinLimit };
+    }
+};
+
+namespace detail
+{
+    /// Tests whether busy-waiting can pay off, which is not the case if the other side cannot run in parallel.
+    inline bool can_spin() noexcept
+    {
+        static bool const multiCore = std::thread::hardware_concurrency() > 1;
+        return multiCore;
+    }
+
+    /// Hints the CPU that the caller is busy-waiting.
+    inline void cpu_relax() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    /// Carries out the polling of a WaitStrategy ahead of parking.
+    ///
+    /// For WaitStrategy::adaptive(), also keeps the average time that receivers waited, which may be updated by
+    /// multiple receivers at once. Updates may then get lost, which only makes the average less precise.
+    class Spinner
+    {
+      public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit Spinner(WaitStrategy strategy = {}) noexcept:
+            _strategy { strategy }, _averageWait { (strategy.spinLimit / 2).count() }
+        {
+        }
+
+        Spinner(Spinner&& other) noexcept:
+            _strategy { other._strategy }, _averageWait { other._averageWait.load(std::memory_order_relaxed) }
+        {
+        }
+
+        Spinner& operator=(Spinner&& other) noexcept
+        {
+            _strategy = other._strategy;
+            _averageWait.store(other._averageWait.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+
+        [[nodiscard]] WaitStrategy strategy() const noexcept
+        {
+            return _strategy;
+        }
+
+        /// Returns when the wait started, as needed by spin() and parked(). Only reads the clock if adaptive.
+        [[nodiscard]] Clock::time_point start() const noexcept
+        {
+            return _strategy.mode == WaitStrategy::Mode::Adaptive ? Clock::now() : Clock::time_point {};
+        }
+
+        /// Polls @p ready as the strategy says, but not past @p deadline.
+        ///
+        /// @returns true if @p ready was satisfied, false if the receiver is to park.
+        template <typename TimePoint, typename Ready>
+        bool spin(Clock::time_point waitStart, TimePoint deadline, Ready&& ready);
+
+        /// Accounts for a wait that started at @p waitStart and ended after parking.
+        void parked(Clock::time_point waitStart) noexcept
+        {
+            if (_strategy.mode == WaitStrategy::Mode::Adaptive)
+                record(Clock::now() - waitStart);
+        }
+
+      private:
+        /// Polls @p ready once, pausing beforehand.
+        template <typename Ready>
+        static bool poll(Ready& ready, bool yield)
+        {
+            if (yield || !can_spin())
+                std::this_thread::yield();
+            else
+                cpu_relax();
+            return ready();
+        }
+
+        /// Adds @p wait to the moving average, weighing it 1/8.
+        void record(Clock::duration wait) noexcept
+        {
+            // Long idle periods count as just beyond the limit, so that the average recovers quickly afterwards.
+            auto const sample = std::min<int64_t>(std::chrono::nanoseconds { wait }.count(),
+                                                  2 * _strategy.spinLimit.count());
+            auto const average = _averageWait.load(std::memory_order_relaxed);
+            _averageWait.store(average + (sample - average) / 8, std::memory_order_relaxed);
+        }
+
+        /// The number of polls between two readings of the clock.
+        static constexpr uint32_t PollsPerClockRead = 64;
+
+        WaitStrategy _strategy;
+        std::atomic<int64_t> _averageWait; // In nanoseconds. Only used if adaptive.
+    };
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+
+template <typename TimePoint, typename Ready>
+bool detail::Spinner::spin(Clock::time_point waitStart, TimePoint deadline, Ready&& ready)
+{
+    switch (_strategy.mode)
+    {
+        case WaitStrategy::Mode::Park:
+            return false;
+
+        case WaitStrategy::Mode::BusySpin:
+            for (uint32_t i = 1;; ++i)
+            {
+                if (poll(ready, false))
+                    return true;
+                if (i % PollsPerClockRead == 0 && TimePoint::clock::now() >= deadline)
+                    return false;
+            }
+
+        case WaitStrategy::Mode::SpinThenPark:
+            for (uint32_t i = 0; can_spin() && i < _strategy.spins; ++i)
+                if (poll(ready, false))
+                    return true;
+            for (uint32_t i = 0; i < _strategy.yields; ++i)
+                if (poll(ready, true))
+                    return true;
+            return false;
+
+        case WaitStrategy::Mode::Adaptive:
+        {
+            auto const budget = std::chrono::nanoseconds { 2 * _averageWait.load(std::memory_order_relaxed) };
+            if (budget > _strategy.spinLimit)
+                return false; // Values arrive too far apart to be worth polling for.
+
+            auto const spinUntil = Clock::now() + budget;
+            for (uint32_t i = 1;; ++i)
+            {
+                if (poll(ready, false))
+                {
+                    record(Clock::now() - waitStart);
+                    return true;
+                }
+                if (i % PollsPerClockRead == 0 && (Clock::now() >= spinUntil || TimePoint::clock::now() >= deadline))
+                    return false;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace actor
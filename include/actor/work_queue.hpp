@@ -0,0 +1,260 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <actor/channel.hpp>
+
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace channel
+{
+
+/// Channel distributing values among a pool of competing worker threads, each value going to exactly one of them.
+///
+/// Unlike Channel, which wakes up receivers in FIFO order, idle workers park on their own condition variable in a
+/// LIFO stack, and a send wakes up the most recently idle one, which is the one most likely to still have a warm
+/// cache. At most one worker is being woken up at a time: once running, it wakes up the next idle worker only if
+/// there is still work left. A burst of values therefore ramps up workers one by one instead of paying for a
+/// thread wakeup per value, and workers that are not needed stay asleep.
+///
+/// A work queue has its own mutex and cannot be used with Controller::select.
+///
+/// @code
+/// auto jobs = channel::WorkQueue<Job> {};
+/// for (auto& worker: workers)
+///     worker = std::thread { [&] { while (auto job = jobs.receive()) job->run(); } };
+/// jobs.send(Job { ... });
+/// @endcode
+template <typename T>
+class [[nodiscard]] WorkQueue
+{
+  public:
+    using value_type = T;
+
+    /// Constructs a work queue.
+    ///
+    /// @param maxBufferSize The maximum number of values waiting for a worker.
+    /// @param name The name of the work queue.
+    ///
+    /// @throw std::invalid_argument for a rendezvous buffer size.
+    explicit WorkQueue(MessageBufferSize maxBufferSize = MessageBufferSize::unbounded(), std::string name = {});
+
+    WorkQueue(WorkQueue&&) = delete;
+    WorkQueue(WorkQueue const&) = delete;
+    WorkQueue& operator=(WorkQueue&&) = delete;
+    WorkQueue& operator=(WorkQueue const&) = delete;
+
+    /// Closes the work queue.
+    ~WorkQueue();
+
+    /// Retrieves the name, useful for introspection/debugging purposes.
+    [[nodiscard]] std::string const& name() const noexcept
+    {
+        return _name;
+    }
+
+    /// Returns the maximum number of values waiting for a worker.
+    [[nodiscard]] size_t capacity() const noexcept
+    {
+        return _maxBufferSize.value;
+    }
+
+    /// Returns the number of buffered values.
+    [[nodiscard]] size_t size() const noexcept;
+
+    /// Returns true if no values are buffered, false otherwise.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    /// Returns the number of workers currently waiting in receive().
+    [[nodiscard]] size_t idle_workers() const noexcept;
+
+    /// Sends @p value to the workers, waking up an idle one unless another one is already being woken up.
+    ///
+    /// If the buffer is full, the caller will be blocked until a worker has taken a value.
+    /// If the work queue gets closed meanwhile, the value is discarded.
+    template <typename U>
+        requires std::convertible_to<U, T>
+    void send(U&& value);
+
+    /// Receives the next value, blocking until one is available.
+    ///
+    /// @returns the received value, or std::nullopt if the work queue is closed and drained.
+    [[nodiscard]] std::optional<T> receive();
+
+    /// Tries to receive a value without blocking, returning std::nullopt if no value is available.
+    [[nodiscard]] std::optional<T> try_receive();
+
+    /// Closes the work queue. Workers receive the buffered values first, then std::nullopt.
+    void close() noexcept;
+
+  private:
+    /// A worker parked in receive().
+    struct IdleWorker
+    {
+        std::condition_variable condition;
+        bool signalled = false;
+        IdleWorker* next = nullptr;
+    };
+
+    /// Takes the oldest buffered value and wakes up whoever can make progress now. The mutex must be held.
+    [[nodiscard]] T take_locked();
+
+    /// Wakes up the most recently idle worker, unless one is already being woken up. The mutex must be held.
+    void wake_worker() noexcept;
+
+    static MessageBufferSize validated(MessageBufferSize maxBufferSize);
+
+    mutable std::mutex _mutex;
+    std::condition_variable _senderCondition;
+    size_t _blockedSenders = 0;
+    IdleWorker* _idleWorkers = nullptr; // The most recently idle worker first.
+    bool _waking = false;               // Whether a signalled worker has not taken the mutex yet.
+    MessageBufferSize _maxBufferSize;
+    detail::ChannelBuffer<T> _queue;
+    bool _closed = false;
+    std::string _name;
+};
+
+// ----------------------------------------------------------------------------
+
+template <typename T>
+WorkQueue<T>::WorkQueue(MessageBufferSize maxBufferSize, std::string name):
+    _maxBufferSize { validated(maxBufferSize) }, _queue { maxBufferSize }, _name { std::move(name) }
+{
+}
+
+template <typename T>
+MessageBufferSize WorkQueue<T>::validated(MessageBufferSize maxBufferSize)
+{
+    if (maxBufferSize.value == MessageBufferSize::rendezvous().value)
+        throw std::invalid_argument("WorkQueue requires a non-zero buffer size");
+
+    return maxBufferSize;
+}
+
+template <typename T>
+WorkQueue<T>::~WorkQueue()
+{
+    close();
+}
+
+template <typename T>
+size_t WorkQueue<T>::size() const noexcept
+{
+    auto _ = std::unique_lock { _mutex };
+    return _queue.size();
+}
+
+template <typename T>
+size_t WorkQueue<T>::idle_workers() const noexcept
+{
+    auto _ = std::unique_lock { _mutex };
+    auto count = size_t { 0 };
+    for (auto* worker = _idleWorkers; worker; worker = worker->next)
+        ++count;
+    return count;
+}
+
+template <typename T>
+template <typename U>
+    requires std::convertible_to<U, T>
+void WorkQueue<T>::send(U&& value)
+{
+    auto lock = std::unique_lock { _mutex };
+
+    auto const accepted = [this]() { return _queue.size() < _maxBufferSize.value || _closed; };
+    if (!accepted())
+    {
+        ++_blockedSenders;
+        _senderCondition.wait(lock, accepted);
+        --_blockedSenders;
+    }
+
+    if (_closed)
+        return; // The work queue was closed while waiting for free space.
+
+    _queue.emplace_back(std::forward<U>(value));
+    wake_worker();
+}
+
+template <typename T>
+void WorkQueue<T>::wake_worker() noexcept
+{
+    auto* worker = _idleWorkers;
+    if (!worker || _waking)
+        return;
+
+    // Notify with the mutex held, as the worker's stack frame may be gone as soon as it can return.
+    _idleWorkers = worker->next;
+    _waking = true;
+    worker->signalled = true;
+    worker->condition.notify_one();
+}
+
+template <typename T>
+T WorkQueue<T>::take_locked()
+{
+    auto value = std::move(_queue.front());
+    _queue.pop_front();
+    if (_blockedSenders != 0)
+        _senderCondition.notify_one();
+    if (!_queue.empty())
+        wake_worker(); // More work than this worker can take: ramp up the next one.
+    return value;
+}
+
+template <typename T>
+std::optional<T> WorkQueue<T>::receive()
+{
+    auto lock = std::unique_lock { _mutex };
+    while (_queue.empty())
+    {
+        if (_closed)
+            return std::nullopt;
+
+        auto self = IdleWorker {};
+        self.next = std::exchange(_idleWorkers, &self);
+        self.condition.wait(lock, [&]() { return self.signalled; });
+        _waking = false;
+        // A busy worker may have taken the value meanwhile, in which case this one parks again.
+    }
+
+    return take_locked();
+}
+
+template <typename T>
+std::optional<T> WorkQueue<T>::try_receive()
+{
+    auto _ = std::unique_lock { _mutex };
+    if (_queue.empty())
+        return std::nullopt;
+
+    return take_locked();
+}
+
+template <typename T>
+void WorkQueue<T>::close() noexcept
+{
+    auto _ = std::unique_lock { _mutex };
+    if (std::exchange(_closed, true))
+        return;
+
+    while (auto* worker = _idleWorkers)
+    {
+        _idleWorkers = worker->next;
+        worker->signalled = true;
+        worker->condition.notify_one();
+    }
+    _senderCondition.notify_all();
+}
+
+} // namespace channel
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Checks BroadcastChannel: fan-out, slow subscriber policies, and how long payloads are kept.
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <actor/broadcast_channel.hpp>
+
+#include "check.hpp"
+
+namespace
+{
+
+using channel::BroadcastChannel;
+using channel::MessageBufferSize;
+using channel::SlowSubscriberPolicy;
+using test::check;
+
+using Payload = std::shared_ptr<std::string const>;
+
+void every_subscriber_receives_every_message()
+{
+    auto channel = BroadcastChannel<int> { MessageBufferSize { 4 } };
+    auto first = channel.subscribe();
+    auto second = channel.subscribe();
+    check(channel.subscribers() == 2, "subscribers counted");
+
+    auto sender = std::thread { [&]() {
+        for (int i = 0; i < 100; ++i)
+            channel.send(i);
+        channel.close();
+    } };
+
+    auto receiveAll = [](BroadcastChannel<int>::Subscription& subscription) {
+        auto values = std::vector<int> {};
+        while (auto value = subscription.receive())
+            values.push_back(**value);
+        return values;
+    };
+    auto other = std::thread { [&]() { check(receiveAll(second).size() == 100, "second got all messages"); } };
+    auto const values = receiveAll(first);
+    sender.join();
+    other.join();
+
+    auto ordered = values.size() == 100;
+    for (size_t i = 0; ordered && i < values.size(); ++i)
+        ordered = values[i] == static_cast<int>(i);
+    check(ordered, "first got all messages in order");
+}
+
+void lapped_subscriber_skips_ahead()
+{
+    auto channel = BroadcastChannel<int> { MessageBufferSize { 4 }, SlowSubscriberPolicy::Lap };
+    auto subscription = channel.subscribe();
+    for (int i = 0; i < 10; ++i)
+        channel.send(i);
+
+    auto const first = subscription.try_receive();
+    check(first && **first == 6, "lapped subscriber resumes at the oldest buffered message");
+    check(subscription.missed() == 6, "missed messages counted");
+}
+
+void payload_released_once_received_by_all()
+{
+    auto channel = BroadcastChannel<std::string> { MessageBufferSize { 4 } };
+    auto first = channel.subscribe();
+    auto second = channel.subscribe();
+
+    auto payload = std::make_shared<std::string const>("quote");
+    auto const watch = std::weak_ptr { payload };
+    channel.send(std::move(payload));
+
+    auto received = first.try_receive();
+    received.reset();
+    check(!watch.expired(), "payload kept for the second subscriber");
+    received = second.try_receive();
+    received.reset();
+    check(watch.expired(), "payload released once all subscribers received it");
+}
+
+void payload_released_on_unsubscribe()
+{
+    auto channel = BroadcastChannel<std::string> { MessageBufferSize { 4 } };
+    auto watch = std::weak_ptr<std::string const> {};
+    {
+        auto subscription = channel.subscribe();
+        auto payload = std::make_shared<std::string const>("quote");
+        watch = payload;
+        channel.send(std::move(payload));
+        check(!watch.expired(), "payload kept for the subscriber");
+    }
+    check(watch.expired(), "payload released when its only subscriber left");
+
+    auto payload = std::make_shared<std::string const>("unheard");
+    watch = payload;
+    channel.send(std::move(payload));
+    check(watch.expired(), "payload not kept without subscribers");
+}
+
+} // namespace
+
+int main()
+{
+    every_subscriber_receives_every_message();
+    lapped_subscriber_skips_ahead();
+    payload_released_once_received_by_all();
+    payload_released_on_unsubscribe();
+    return test::result();
+}
@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Checks channels and the ways of waiting on several of them: select_case() and async_select().
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <optional>
+#include <string>
+#include <thread>
+#include <variant>
+
+#include <actor/channel.hpp>
+#include <actor/executor.hpp>
+#include <actor/spsc_channel.hpp>
+#include <actor/task.hpp>
+
+#include "check.hpp"
+
+namespace
+{
+
+using test::check;
+using namespace std::chrono_literals;
+
+template <typename C>
+concept SendSelectable = requires(C& channel, int value) { channel::send_to(channel, value); };
+
+// A select sending to an SpscChannel would be a second producer next to the channel's own.
+static_assert(SendSelectable<channel::Channel<int>>);
+static_assert(!SendSelectable<channel::SpscChannel<int>>);
+
+void rendezvous_hands_values_over()
+{
+    auto channel = channel::Channel<int> { channel::MessageBufferSize::rendezvous() };
+    check(channel.capacity() == 0, "rendezvous channel has no buffer");
+    check(!channel.send_for(1, 20ms), "send times out without a receiver");
+
+    auto sent = std::async(std::launch::async, [&]() { channel.send(2); });
+    check(sent.wait_for(50ms) == std::future_status::timeout, "send waits for a receiver");
+    check(channel.receive() == 2, "value handed over");
+    check(sent.wait_for(5s) == std::future_status::ready, "send completes once the value is taken");
+
+    auto received = std::async(std::launch::async, [&]() { return channel.receive(); });
+    check(channel.send_for(3, 5s), "send completes against a waiting receiver");
+    check(received.get() == 3, "value handed over to the waiting receiver");
+}
+
+void unbounded_never_blocks()
+{
+    auto channel = channel::Channel<int> { channel::MessageBufferSize::unbounded() };
+    for (int i = 0; i < 100'000; ++i)
+        channel.send(i);
+    check(channel.size() == 100'000, "all values buffered");
+
+    auto ordered = true;
+    for (int i = 0; i < 100'000; ++i)
+        ordered = ordered && channel.try_receive() == i;
+    check(ordered, "values received in order");
+    check(channel.empty(), "channel drained");
+}
+
+void closed_channel_drains_then_ends()
+{
+    auto channel = channel::Channel<int> { channel::MessageBufferSize { 4 } };
+    channel.send(1);
+    channel.close();
+    check(channel.receive() == 1, "buffered value received after close");
+    check(!channel.receive(), "closed and drained channel ends");
+}
+
+void select_case_completes_one_case()
+{
+    auto controller = channel::Controller {};
+    auto input = controller.channel<int>(channel::MessageBufferSize { 1 });
+    auto output = controller.channel<std::string>(channel::MessageBufferSize { 1 });
+    output.send("full");
+
+    auto value = std::string { "sent" };
+    input.send(1);
+    auto result = controller.select_case(channel::receive_from(input), channel::send_to(output, std::move(value)));
+    check(result && result->index() == 0 && std::get<0>(*result) == 1, "ready receive case completed");
+    check(value == "sent", "value of the send case not moved from");
+
+    check(output.receive() == "full", "room made in the output");
+    result = controller.select_case(channel::receive_from(input), channel::send_to(output, std::move(value)));
+    check(result && result->index() == 1, "ready send case completed");
+    check(output.receive() == "sent", "value of the send case sent");
+
+    check(!controller.select_case_for(20ms, channel::receive_from(input)), "select times out without a ready case");
+
+    input.close();
+    output.close();
+    check(!controller.select_case(channel::receive_from(input)), "select ends once all channels are closed");
+}
+
+void select_case_sends_to_waiting_rendezvous_receiver()
+{
+    auto controller = channel::Controller {};
+    auto channel = controller.channel<int>(channel::MessageBufferSize::rendezvous());
+    auto received = std::async(std::launch::async, [&]() { return channel.receive(); });
+    auto const result = controller.select_case_for(5s, channel::send_to(channel, 7));
+    check(result && result->index() == 0, "send case completed against the waiting receiver");
+    check(received.get() == 7, "value handed over");
+}
+
+void async_select_reports_ready_channels()
+{
+    auto executor = actor::Executor { 1 };
+    auto controller = channel::Controller {};
+    auto a = controller.channel<int>(channel::MessageBufferSize { 4 });
+    auto b = controller.channel<int>(channel::MessageBufferSize { 4 });
+    auto ready = std::promise<channel::ReadySet<2>> {};
+
+    actor::spawn(executor, [](channel::Controller& controller, channel::Channel<int>& a, channel::Channel<int>& b,
+                              std::promise<channel::ReadySet<2>>& ready) -> actor::Task<> {
+        ready.set_value(co_await controller.async_select(a, b));
+    }(controller, a, b, ready));
+
+    b.send(1);
+    auto future = ready.get_future();
+    check(future.wait_for(5s) == std::future_status::ready, "select resumed by a send");
+    auto const set = future.get();
+    check(set.size() == 1 && set.contains(1), "the channel sent to reported");
+}
+
+/// Keeps the only worker of an executor busy until released, so that everything scheduled meanwhile queues up.
+class WorkerBlocker
+{
+  public:
+    explicit WorkerBlocker(actor::Executor& executor)
+    {
+        actor::spawn(executor, block());
+        _started.get_future().wait();
+    }
+
+    void release()
+    {
+        _released.set_value();
+    }
+
+  private:
+    actor::Task<> block()
+    {
+        _started.set_value();
+        _released.get_future().wait();
+        co_return;
+    }
+
+    std::promise<void> _started;
+    std::promise<void> _released;
+};
+
+/// An async_select() signalled by several of its channels before it resumes must still resume only once.
+template <typename Signal>
+void async_select_resumes_once(Signal signal)
+{
+    auto executor = actor::Executor { 1 };
+    auto controller = channel::Controller {};
+    auto a = controller.channel<int>(channel::MessageBufferSize { 4 });
+    auto b = controller.channel<int>(channel::MessageBufferSize { 4 });
+    auto resumed = std::atomic<int> { 0 };
+    auto done = std::promise<void> {};
+
+    actor::spawn(executor, [](channel::Controller& controller, channel::Channel<int>& a, channel::Channel<int>& b,
+                              std::atomic<int>& resumed, std::promise<void>& done) -> actor::Task<> {
+        (void)co_await controller.async_select(a, b);
+        ++resumed;
+        done.set_value();
+    }(controller, a, b, resumed, done));
+
+    // The select runs and suspends before the blocker, which then holds back its resumptions.
+    auto blocker = WorkerBlocker { executor };
+    signal(controller, a, b);
+    blocker.release();
+
+    check(done.get_future().wait_for(5s) == std::future_status::ready, "select resumed");
+    std::this_thread::sleep_for(20ms); // Give a second resumption the chance to run.
+    check(resumed.load() == 1, "select resumed once");
+}
+
+} // namespace
+
+int main()
+{
+    rendezvous_hands_values_over();
+    unbounded_never_blocks();
+    closed_channel_drains_then_ends();
+    select_case_completes_one_case();
+    select_case_sends_to_waiting_rendezvous_receiver();
+    async_select_reports_ready_channels();
+    async_select_resumes_once([](channel::Controller& controller, auto&, auto&) { controller.terminate(); });
+    async_select_resumes_once([](channel::Controller&, auto& a, auto& b) {
+        a.send(1);
+        b.close();
+    });
+    return test::result();
+}
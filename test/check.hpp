@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+#include <source_location>
+#include <string_view>
+
+namespace test
+{
+
+inline int failures = 0;
+
+/// Reports @p what as failed unless @p condition holds, and carries on with the test.
+inline void check(bool condition,
+                  std::string_view what,
+                  std::source_location const& where = std::source_location::current())
+{
+    if (condition)
+        return;
+    std::cerr << where.file_name() << ':' << where.line() << ": FAILED: " << what << '\n';
+    ++failures;
+}
+
+/// The exit code of a test program, reflecting whether any check failed.
+inline int result() noexcept
+{
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // namespace test
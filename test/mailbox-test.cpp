@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Checks actor mailboxes: overflow policies, priority lanes and batches.
+
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <actor/mailbox.hpp>
+
+#include "check.hpp"
+
+namespace
+{
+
+using actor::Mailbox;
+using actor::MailboxOptions;
+using actor::OverflowPolicy;
+using actor::Priority;
+using test::check;
+using namespace std::chrono_literals;
+
+/// Pops everything, returning the values in the order they were dequeued.
+std::vector<int> drain(Mailbox<int>& mailbox)
+{
+    auto values = std::vector<int> {};
+    while (auto value = mailbox.try_pop())
+        values.push_back(*value);
+    return values;
+}
+
+/// Counts how many of @p count normal messages a mailbox accepts.
+size_t accepted(Mailbox<int>& mailbox, size_t count)
+{
+    auto accepted = size_t { 0 };
+    for (size_t i = 0; i < count; ++i)
+        if (mailbox.push(static_cast<int>(i)))
+            ++accepted;
+    return accepted;
+}
+
+/// Fills a mailbox of capacity 2 with 0 and 1, then pushes 2.
+Mailbox<int>& overflow(Mailbox<int>& mailbox, bool expectAccepted)
+{
+    check(mailbox.push(0) && mailbox.push(1), "pushes within capacity accepted");
+    check(mailbox.push(2) == expectAccepted, "overflowing push result");
+    return mailbox;
+}
+
+void drop_newest_discards_the_new_message()
+{
+    auto mailbox = Mailbox<int> { MailboxOptions { .capacity = 2, .overflow = OverflowPolicy::DropNewest } };
+    check(drain(overflow(mailbox, true)) == std::vector { 0, 1 }, "newest message dropped");
+    check(mailbox.statistics().dropped == 1, "dropped message counted");
+}
+
+void drop_oldest_discards_the_oldest_message()
+{
+    auto mailbox = Mailbox<int> { MailboxOptions { .capacity = 2, .overflow = OverflowPolicy::DropOldest } };
+    check(drain(overflow(mailbox, true)) == std::vector { 1, 2 }, "oldest message dropped");
+    check(mailbox.statistics().dropped == 1, "dropped message counted");
+}
+
+void fail_rejects_the_new_message()
+{
+    auto mailbox = Mailbox<int> { MailboxOptions { .capacity = 2, .overflow = OverflowPolicy::Fail } };
+    check(drain(overflow(mailbox, false)) == std::vector { 0, 1 }, "new message rejected");
+    check(mailbox.statistics().rejected == 1, "rejected message counted");
+}
+
+void block_waits_for_room()
+{
+    auto mailbox = Mailbox<int> { MailboxOptions { .capacity = 2, .overflow = OverflowPolicy::Block } };
+    check(mailbox.push(0) && mailbox.push(1), "pushes within capacity accepted");
+    check(!mailbox.try_push(2), "try_push() rejects when full");
+
+    auto blocked = std::async(std::launch::async, [&]() { return mailbox.push(2); });
+    check(blocked.wait_for(50ms) == std::future_status::timeout, "sender blocks while full");
+    check(mailbox.try_pop() == 0, "oldest message popped");
+    check(blocked.get(), "blocked sender accepted once there is room");
+    check(drain(mailbox) == std::vector { 1, 2 }, "messages in order");
+    check(mailbox.statistics().blocked == 1, "blocked sender counted");
+
+    check(mailbox.push(3) && mailbox.push(4), "pushes within capacity accepted");
+    blocked = std::async(std::launch::async, [&]() { return mailbox.push(5); });
+    check(blocked.wait_for(50ms) == std::future_status::timeout, "sender blocks while full");
+    mailbox.close();
+    check(!blocked.get(), "blocked sender rejected once closed");
+}
+
+void higher_priorities_go_first()
+{
+    auto mailbox = Mailbox<int> {};
+    mailbox.push(1);
+    mailbox.push(2, Priority::High);
+    mailbox.push(3, Priority::System);
+    mailbox.push(4);
+    mailbox.push(5, Priority::High);
+    check(drain(mailbox) == std::vector { 3, 2, 5, 1, 4 }, "dequeued by priority, then in order");
+}
+
+void batches_keep_their_order()
+{
+    auto mailbox = Mailbox<int> {};
+    auto const values = std::vector { 1, 2, 3 };
+    check(mailbox.push_batch(values) == 3, "lvalue batch accepted");
+    check(values.size() == 3, "lvalue batch copied");
+    check(mailbox.push_batch(std::vector { 4, 5 }, Priority::High) == 2, "urgent batch accepted");
+    check(drain(mailbox) == std::vector { 4, 5, 1, 2, 3 }, "batches dequeued by priority, then in order");
+
+    auto bounded = Mailbox<int> { MailboxOptions { .capacity = 2, .overflow = OverflowPolicy::Fail } };
+    check(bounded.push_batch(std::vector { 1, 2, 3 }) == 2, "bounded batch stops at the first rejected message");
+    check(drain(bounded) == std::vector { 1, 2 }, "accepted part of the batch dequeued");
+}
+
+void concurrent_producers_keep_their_order()
+{
+    constexpr int ProducerCount = 4;
+    constexpr int MessageCount = 10'000;
+
+    auto mailbox = Mailbox<int> { MailboxOptions { .capacity = 64, .overflow = OverflowPolicy::Block } };
+    auto producers = std::vector<std::thread> {};
+    for (int producer = 0; producer < ProducerCount; ++producer)
+        producers.emplace_back([&mailbox, producer]() {
+            for (int i = 0; i < MessageCount; ++i)
+                mailbox.push(producer * MessageCount + i);
+        });
+
+    auto next = std::vector<int>(ProducerCount, 0);
+    auto ordered = true;
+    for (int received = 0; received < ProducerCount * MessageCount; ++received)
+    {
+        auto const value = mailbox.pop().value_or(-1);
+        auto const producer = value / MessageCount;
+        ordered = ordered && value >= 0 && value % MessageCount == next[producer]++;
+    }
+    for (auto& producer: producers)
+        producer.join();
+
+    check(ordered, "every producer's messages received in order");
+    check(mailbox.empty(), "nothing left over");
+}
+
+void urgent_batch_is_counted_against_capacity()
+{
+    auto mailbox = Mailbox<int> { MailboxOptions { .capacity = 4, .overflow = OverflowPolicy::Fail } };
+    check(mailbox.push_batch(std::vector { 1, 2 }, Priority::High) == 2, "urgent batch accepted");
+    check(drain(mailbox) == std::vector { 1, 2 }, "urgent batch drained");
+    check(accepted(mailbox, 5) == 4, "capacity intact after draining an urgent batch");
+}
+
+void urgent_batch_is_bounded_with_drop_oldest()
+{
+    auto mailbox = Mailbox<int> { MailboxOptions { .capacity = 4, .overflow = OverflowPolicy::DropOldest } };
+    check(mailbox.push_batch(std::vector { 1, 2, 3, 4, 5, 6 }, Priority::High) == 6, "urgent batch accepted");
+    check(drain(mailbox) == std::vector { 3, 4, 5, 6 }, "oldest urgent messages displaced");
+    check(mailbox.statistics().dropped == 2, "displaced messages counted");
+    check(accepted(mailbox, 5) == 5, "capacity intact after draining");
+    check(drain(mailbox) == std::vector { 1, 2, 3, 4 }, "oldest normal message displaced");
+}
+
+} // namespace
+
+int main()
+{
+    drop_newest_discards_the_new_message();
+    drop_oldest_discards_the_oldest_message();
+    fail_rejects_the_new_message();
+    block_waits_for_room();
+    higher_priorities_go_first();
+    batches_keep_their_order();
+    concurrent_producers_keep_their_order();
+    urgent_batch_is_counted_against_capacity();
+    urgent_batch_is_bounded_with_drop_oldest();
+    return test::result();
+}
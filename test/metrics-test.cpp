@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Checks that the metrics account for every acquisition of a controller's mutex, on the coroutine paths too.
+
+// The metrics are what is being tested, however the rest of the build is configured.
+#undef ACTOR_METRICS
+#define ACTOR_METRICS 1
+
+#include <chrono>
+#include <future>
+#include <optional>
+#include <thread>
+
+#include <actor/channel.hpp>
+#include <actor/executor.hpp>
+#include <actor/task.hpp>
+
+#include "check.hpp"
+
+namespace
+{
+
+using test::check;
+using namespace std::chrono_literals;
+
+/// Receives one value from @p channel in a coroutine, and returns it once the coroutine has it.
+std::optional<int> receive_in_coroutine(actor::Executor& executor,
+                                        channel::Channel<int>& channel,
+                                        std::promise<std::optional<int>>& received)
+{
+    actor::spawn(executor, [](channel::Channel<int>& channel, std::promise<std::optional<int>>& received)
+                     -> actor::Task<> { received.set_value(co_await channel.async_receive()); }(channel, received));
+    auto future = received.get_future();
+    if (future.wait_for(5s) != std::future_status::ready)
+        return std::nullopt;
+    return future.get();
+}
+
+void coroutine_locks_are_counted()
+{
+    auto executor = actor::Executor { 1 };
+    auto controller = channel::Controller {};
+    auto channel = controller.channel<int>(channel::MessageBufferSize { 4 });
+
+    // The value is there already, so the coroutine does not suspend: one lock, taken in await_suspend().
+    channel.send(1);
+    auto before = controller.metrics().lockAcquisitions;
+    auto received = std::promise<std::optional<int>> {};
+    check(receive_in_coroutine(executor, channel, received) == 1, "value received without waiting");
+    check(controller.metrics().lockAcquisitions - before == 1, "lock taken when suspending counted");
+
+    // The coroutine waits: one lock to suspend, one to send, one to complete the receive when resumed.
+    auto waiting = std::promise<std::optional<int>> {};
+    before = controller.metrics().lockAcquisitions;
+    auto resumed = std::async(std::launch::async, [&]() { return receive_in_coroutine(executor, channel, waiting); });
+    // Once the coroutine has taken the lock, sending has to wait until it is registered as a receiver.
+    while (controller.metrics().lockAcquisitions == before)
+        std::this_thread::yield();
+    channel.send(2);
+    check(resumed.get() == 2, "value received after waiting");
+    check(controller.metrics().lockAcquisitions - before == 3, "lock taken when resuming counted");
+}
+
+} // namespace
+
+int main()
+{
+    coroutine_locks_are_counted();
+    return test::result();
+}
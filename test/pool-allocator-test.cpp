@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Checks PoolAllocator: block reuse, frees from other threads, and queues using it.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <actor/channel.hpp>
+#include <actor/mailbox.hpp>
+#include <actor/pool_allocator.hpp>
+
+#include "check.hpp"
+
+namespace
+{
+
+using actor::PoolAllocator;
+using test::check;
+
+void freed_blocks_are_reused()
+{
+    auto allocator = PoolAllocator<std::uint64_t> {};
+    auto* first = allocator.allocate(4);
+    allocator.deallocate(first, 4);
+    auto* second = allocator.allocate(4);
+    check(second == first, "freed block reused by the same thread");
+    allocator.deallocate(second, 4);
+}
+
+void blocks_are_aligned_and_distinct()
+{
+    auto allocator = PoolAllocator<std::max_align_t> {};
+    auto blocks = std::vector<std::max_align_t*> {};
+    for (int i = 0; i < 1000; ++i)
+        blocks.push_back(allocator.allocate(1));
+
+    auto aligned = true;
+    for (auto* block: blocks)
+        aligned = aligned && reinterpret_cast<std::uintptr_t>(block) % alignof(std::max_align_t) == 0;
+    check(aligned, "blocks aligned");
+
+    auto sorted = blocks;
+    std::ranges::sort(sorted);
+    check(std::ranges::adjacent_find(sorted) == sorted.end(), "blocks distinct");
+
+    for (auto* block: blocks)
+        allocator.deallocate(block, 1);
+}
+
+void blocks_freed_by_another_thread_return_to_their_pool()
+{
+    auto allocator = PoolAllocator<std::uint64_t> {};
+    auto blocks = std::vector<std::uint64_t*> {};
+    for (int i = 0; i < 100; ++i)
+        blocks.push_back(allocator.allocate(2));
+
+    std::thread { [&]() {
+        for (auto* block: blocks)
+            allocator.deallocate(block, 2);
+    } }.join();
+
+    // Once its own free list runs dry, which takes a few slabs' worth of blocks at most, the owner takes over
+    // the blocks freed remotely.
+    std::ranges::sort(blocks);
+    auto reused = size_t { 0 };
+    auto allocated = std::vector<std::uint64_t*> {};
+    for (size_t i = 0; i < 4 * actor::detail::SlabPool::SlabSize / actor::detail::SlabPool::MinBlockSize; ++i)
+    {
+        allocated.push_back(allocator.allocate(2));
+        if (std::ranges::binary_search(blocks, allocated.back()))
+            ++reused;
+    }
+    check(reused == blocks.size(), "remotely freed blocks reused by the owner");
+    for (auto* block: allocated)
+        allocator.deallocate(block, 2);
+}
+
+void large_allocations_bypass_the_pool()
+{
+    auto allocator = PoolAllocator<std::byte> {};
+    auto* block = allocator.allocate(actor::detail::SlabPool::MaxBlockSize + 1);
+    check(block != nullptr, "large allocation served");
+    allocator.deallocate(block, actor::detail::SlabPool::MaxBlockSize + 1);
+}
+
+void queues_work_with_the_pool()
+{
+    auto mailbox = actor::Mailbox<int, PoolAllocator<int>> {};
+    auto channel = channel::Channel<int, PoolAllocator<int>> { channel::MessageBufferSize::unbounded() };
+    auto consumer = std::thread { [&]() {
+        for (int i = 0; i < 10'000; ++i)
+            channel.send(mailbox.pop().value_or(-1));
+    } };
+
+    for (int i = 0; i < 10'000; ++i)
+        mailbox.push(int { i });
+
+    auto ordered = true;
+    for (int i = 0; i < 10'000; ++i)
+        ordered = ordered && channel.receive() == i;
+    consumer.join();
+    check(ordered, "values passed through pooled queues in order");
+}
+
+} // namespace
+
+int main()
+{
+    freed_blocks_are_reused();
+    blocks_are_aligned_and_distinct();
+    blocks_freed_by_another_thread_return_to_their_pool();
+    large_allocations_bypass_the_pool();
+    queues_work_with_the_pool();
+    return test::result();
+}
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Checks Selector: level-triggered readiness across channels that are added and removed at runtime.
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <actor/channel.hpp>
+#include <actor/selector.hpp>
+
+#include "check.hpp"
+
+namespace
+{
+
+using channel::Channel;
+using channel::Controller;
+using channel::MessageBufferSize;
+using channel::Selector;
+using test::check;
+using namespace std::chrono_literals;
+
+std::vector<Selector::Key> sorted(std::span<Selector::Key const> keys)
+{
+    auto result = std::vector(keys.begin(), keys.end());
+    std::ranges::sort(result);
+    return result;
+}
+
+void reports_readable_channels()
+{
+    auto controller = Controller {};
+    auto a = controller.channel<int>(MessageBufferSize { 4 });
+    auto b = controller.channel<int>(MessageBufferSize { 4 });
+    auto c = controller.channel<int>(MessageBufferSize { 4 });
+    auto selector = Selector { controller };
+    selector.add(a, 10);
+    selector.add(b, 20);
+    selector.add(c, 30);
+    check(selector.size() == 3, "channels counted");
+
+    check(selector.wait_for(20ms).empty(), "wait times out without readable channels");
+
+    a.send(1);
+    c.send(3);
+    check(sorted(selector.wait()) == std::vector<Selector::Key> { 10, 30 }, "readable channels reported");
+
+    // Level-triggered: a channel stays reported until drained.
+    (void)a.try_receive();
+    check(sorted(selector.wait()) == std::vector<Selector::Key> { 30 }, "channel with values left reported again");
+
+    (void)c.try_receive();
+    b.close();
+    check(sorted(selector.wait()) == std::vector<Selector::Key> { 20 }, "closed channel reported");
+
+    check(selector.remove(b), "channel removed");
+    check(!selector.remove(b), "channel removed only once");
+    check(selector.size() == 2, "removed channel no longer counted");
+}
+
+void wakes_up_on_send()
+{
+    auto controller = Controller {};
+    auto a = controller.channel<int>(MessageBufferSize { 4 });
+    auto selector = Selector { controller };
+    selector.add(a, 1);
+
+    auto keys = std::async(std::launch::async, [&]() { return sorted(selector.wait_for(5s)); });
+    check(keys.wait_for(20ms) == std::future_status::timeout, "wait blocks without readable channels");
+    a.send(1);
+    check(keys.get() == std::vector<Selector::Key> { 1 }, "waiting selector woken up by a send");
+}
+
+void rejects_foreign_and_duplicate_channels()
+{
+    auto controller = Controller {};
+    auto other = Controller {};
+    auto a = controller.channel<int>(MessageBufferSize { 4 });
+    auto foreign = other.channel<int>(MessageBufferSize { 4 });
+    auto selector = Selector { controller };
+    selector.add(a, 1);
+
+    auto threw = false;
+    try
+    {
+        selector.add(a, 2);
+    }
+    catch (std::invalid_argument const&)
+    {
+        threw = true;
+    }
+    check(threw, "duplicate channel rejected");
+
+    threw = false;
+    try
+    {
+        selector.add(foreign, 3);
+    }
+    catch (channel::ControllerMismatchError const&)
+    {
+        threw = true;
+    }
+    check(threw, "channel of another controller rejected");
+}
+
+} // namespace
+
+int main()
+{
+    reports_readable_channels();
+    wakes_up_on_send();
+    rejects_foreign_and_duplicate_channels();
+    return test::result();
+}
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Checks that timers fire on time, in particular a short timer scheduled while the wheel's thread already sleeps
+// until a later one.
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include <actor/timer_wheel.hpp>
+
+#include "check.hpp"
+
+namespace
+{
+
+using Clock = actor::TimerWheel::Clock;
+using test::check;
+using namespace std::chrono_literals;
+
+/// How late a timer may fire, allowing for a loaded machine.
+constexpr auto Tolerance = 100ms;
+
+/// The time a timer fired at, which can be waited for.
+class Fired
+{
+  public:
+    void operator()()
+    {
+        auto _ = std::unique_lock { _mutex };
+        _time = Clock::now();
+        _condition.notify_all();
+    }
+
+    std::optional<Clock::time_point> wait_for(Clock::duration timeout)
+    {
+        auto lock = std::unique_lock { _mutex };
+        _condition.wait_for(lock, timeout, [this]() { return _time.has_value(); });
+        return _time;
+    }
+
+  private:
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::optional<Clock::time_point> _time;
+};
+
+void shorter_timer_wakes_up_the_wheel()
+{
+    auto timers = actor::TimerWheel {};
+    auto longFired = Fired {};
+    auto shortFired = Fired {};
+
+    auto const longStart = Clock::now();
+    timers.schedule_after(400ms, [&]() { longFired(); });
+    std::this_thread::sleep_for(20ms); // Let the wheel's thread go to sleep until the long timer.
+
+    auto const shortStart = Clock::now();
+    timers.schedule_after(10ms, [&]() { shortFired(); });
+
+    auto const shortTime = shortFired.wait_for(1s);
+    check(shortTime.has_value(), "short timer fired");
+    if (shortTime)
+    {
+        check(*shortTime >= shortStart + 10ms, "short timer not early");
+        check(*shortTime < shortStart + 10ms + Tolerance, "short timer on time");
+    }
+
+    auto const longTime = longFired.wait_for(2s);
+    check(longTime.has_value(), "long timer fired");
+    if (longTime)
+        check(*longTime >= longStart + 400ms, "long timer not early");
+}
+
+void cancelled_timer_does_not_fire()
+{
+    auto timers = actor::TimerWheel {};
+    auto fired = Fired {};
+    auto const id = timers.schedule_after(20ms, [&]() { fired(); });
+    check(timers.cancel(id), "timer cancelled");
+    check(!fired.wait_for(100ms).has_value(), "cancelled timer not fired");
+    check(timers.pending() == 0, "no timer pending");
+}
+
+} // namespace
+
+int main()
+{
+    shorter_timer_wakes_up_the_wheel();
+    cancelled_timer_does_not_fire();
+    return test::result();
+}
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Checks WorkQueue: every value goes to exactly one of the competing workers.
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <actor/work_queue.hpp>
+
+#include "check.hpp"
+
+namespace
+{
+
+using channel::MessageBufferSize;
+using channel::WorkQueue;
+using test::check;
+using namespace std::chrono_literals;
+
+void each_value_goes_to_one_worker()
+{
+    constexpr int WorkerCount = 4;
+    constexpr int ValueCount = 20'000;
+
+    auto queue = WorkQueue<int> { MessageBufferSize { 64 } };
+    auto seen = std::vector<std::atomic<int>>(ValueCount);
+    auto workers = std::vector<std::thread> {};
+    for (int i = 0; i < WorkerCount; ++i)
+        workers.emplace_back([&]() {
+            while (auto value = queue.receive())
+                ++seen[static_cast<size_t>(*value)];
+        });
+
+    for (int i = 0; i < ValueCount; ++i)
+        queue.send(i);
+    queue.close();
+    for (auto& worker: workers)
+        worker.join();
+
+    auto once = true;
+    for (auto const& count: seen)
+        once = once && count.load() == 1;
+    check(once, "every value received exactly once");
+}
+
+void closed_queue_drains_then_ends()
+{
+    auto queue = WorkQueue<int> {};
+    queue.send(1);
+    queue.send(2);
+    queue.close();
+    check(queue.receive() == 1 && queue.receive() == 2, "buffered values received after close");
+    check(!queue.receive(), "closed and drained queue ends");
+}
+
+void full_queue_blocks_sender()
+{
+    auto queue = WorkQueue<int> { MessageBufferSize { 1 } };
+    queue.send(1);
+    auto sent = std::async(std::launch::async, [&]() { queue.send(2); });
+    check(sent.wait_for(50ms) == std::future_status::timeout, "sender blocks while full");
+    check(queue.try_receive() == 1, "value taken");
+    check(sent.wait_for(5s) == std::future_status::ready, "sender proceeds once there is room");
+    check(queue.try_receive() == 2, "blocked value delivered");
+    check(!queue.try_receive(), "nothing left over");
+}
+
+void idle_workers_are_counted()
+{
+    auto queue = WorkQueue<int> {};
+    auto worker = std::thread { [&]() { (void)queue.receive(); } };
+    for (int i = 0; i < 1000 && queue.idle_workers() == 0; ++i)
+        std::this_thread::sleep_for(1ms);
+    check(queue.idle_workers() == 1, "waiting worker counted as idle");
+    queue.send(1);
+    worker.join();
+    check(queue.idle_workers() == 0, "woken worker no longer idle");
+}
+
+} // namespace
+
+int main()
+{
+    each_value_goes_to_one_worker();
+    closed_queue_drains_then_ends();
+    full_queue_blocks_sender();
+    idle_workers_are_counted();
+    return test::result();
+}